@@ -0,0 +1,168 @@
+#include "AnimationManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "SpriteSheet.h"
+
+AnimationManager::AnimationManager()
+= default;
+
+AnimationManager::~AnimationManager()
+= default;
+
+AnimationHandle AnimationManager::CreateClip(const AssetName name, const SpriteSheet& sprite_sheet, const float frames_per_second, const bool loop)
+{
+	const auto clip = m_clips.Intern(name);
+	if (m_clips.IsLoaded(clip))
+	{
+		return clip;
+	}
+
+	const auto frames = sprite_sheet.GetAnimationFrames(name.text);
+	if (frames.empty())
+	{
+		std::cout << "no frames for animation " << name.text << std::endl;
+		return clip;
+	}
+
+	AnimationClip clip_data;
+	clip_data.firstFrame = static_cast<uint32_t>(m_frameRects.size());
+	clip_data.frameCount = static_cast<uint32_t>(frames.size());
+	clip_data.frameDuration = frames_per_second > 0.0f ? 1.0f / frames_per_second : 0.0f;
+	clip_data.loop = loop;
+	for (const auto& frame : frames)
+	{
+		m_frameRects.push_back({ frame.x, frame.y, frame.w, frame.h });
+	}
+
+	m_clips.Set(clip, clip_data);
+	return clip;
+}
+
+AnimationHandle AnimationManager::FindClip(const AssetName name) const
+{
+	const auto clip = m_clips.Find(name);
+	return m_clips.IsLoaded(clip) ? clip : AnimationHandle{};
+}
+
+int AnimationManager::GetClipFrameCount(const AnimationHandle clip) const
+{
+	return m_clips.IsLoaded(clip) ? static_cast<int>(m_clips.Get(clip).frameCount) : 0;
+}
+
+float AnimationManager::GetClipDuration(const AnimationHandle clip) const
+{
+	if (!m_clips.IsLoaded(clip))
+	{
+		return 0.0f;
+	}
+
+	const auto& clip_data = m_clips.Get(clip);
+	return clip_data.frameDuration * static_cast<float>(clip_data.frameCount);
+}
+
+AnimatorHandle AnimationManager::CreateAnimator()
+{
+	if (!m_freeAnimators.empty())
+	{
+		const auto index = m_freeAnimators.back();
+		m_freeAnimators.pop_back();
+		m_animators[index] = Animator{};
+		return AnimatorHandle{ index };
+	}
+
+	m_animators.emplace_back();
+	return AnimatorHandle{ static_cast<uint32_t>(m_animators.size() - 1) };
+}
+
+void AnimationManager::DestroyAnimator(const AnimatorHandle animator)
+{
+	if (!animator.IsValid() || animator.index >= m_animators.size())
+	{
+		return;
+	}
+
+	// an animator without a clip is skipped by Update until the slot is handed out again
+	m_animators[animator.index] = Animator{};
+	m_freeAnimators.push_back(animator.index);
+}
+
+void AnimationManager::Play(const AnimatorHandle animator, const AnimationHandle clip, const float speed)
+{
+	auto& state = m_animators[animator.index];
+	state.speed = speed;
+	if (state.clip == clip)
+	{
+		return;
+	}
+
+	state.clip = clip;
+	state.time = 0.0f;
+	state.frame = m_clips.IsLoaded(clip) ? m_clips.Get(clip).firstFrame : 0;
+}
+
+void AnimationManager::SetSpeed(const AnimatorHandle animator, const float speed)
+{
+	m_animators[animator.index].speed = speed;
+}
+
+bool AnimationManager::IsFinished(const AnimatorHandle animator) const
+{
+	const auto& state = m_animators[animator.index];
+	if (!m_clips.IsLoaded(state.clip))
+	{
+		return true;
+	}
+
+	const auto& clip = m_clips.Get(state.clip);
+	return !clip.loop && state.time >= clip.frameDuration * static_cast<float>(clip.frameCount);
+}
+
+void AnimationManager::Update(const float delta_time)
+{
+	for (auto& state : m_animators)
+	{
+		if (!m_clips.IsLoaded(state.clip))
+		{
+			continue;
+		}
+
+		const auto& clip = m_clips.Get(state.clip);
+		if (clip.frameDuration <= 0.0f || (clip.loop && clip.frameCount < 2))
+		{
+			continue;
+		}
+
+		const auto duration = clip.frameDuration * static_cast<float>(clip.frameCount);
+		state.time += delta_time * state.speed;
+		if (clip.loop)
+		{
+			// wrapped every frame so the time never grows large enough to lose precision
+			state.time = std::fmod(state.time, duration);
+			if (state.time < 0.0f)
+			{
+				state.time += duration;
+			}
+		}
+		else
+		{
+			state.time = std::fmax(0.0f, std::fmin(state.time, duration));
+		}
+
+		const auto frame = std::min(static_cast<uint32_t>(state.time / clip.frameDuration), clip.frameCount - 1);
+		state.frame = clip.firstFrame + frame;
+	}
+}
+
+const SDL_Rect* AnimationManager::GetFrameRect(const AnimatorHandle animator) const
+{
+	const auto& state = m_animators[animator.index];
+	return m_clips.IsLoaded(state.clip) ? &m_frameRects[state.frame] : nullptr;
+}
+
+int AnimationManager::GetAnimatorCount() const
+{
+	return static_cast<int>(m_animators.size() - m_freeAnimators.size());
+}
@@ -0,0 +1,88 @@
+#pragma once
+#ifndef __ANIMATION_MANAGER__
+#define __ANIMATION_MANAGER__
+
+#include <cstdint>
+#include <vector>
+
+#include <SDL.h>
+
+#include "AssetRegistry.h"
+
+class SpriteSheet;
+
+// one playing animation, a Sprite owns one for as long as it lives
+struct AnimatorTag {};
+using AnimatorHandle = AssetHandle<AnimatorTag>;
+
+/* Singleton
+ * Animation clips are immutable and shared by every sprite that plays them: a run of source rects in one
+ * flat array plus a frame duration. Each animator is only the clip it plays, a time and a speed, kept in
+ * a dense array that Update advances in a single pass once a frame by the real time that passed, so
+ * animations run at the same speed whatever the frame rate. Drawing reads the current rect by index.
+ */
+class AnimationManager
+{
+public:
+	static AnimationManager& Instance()
+	{
+		static AnimationManager instance;
+		return instance;
+	}
+
+	/*
+	 * The clip made of the sheet's animation of the same name, megaman-run-0, megaman-run-1... Only the first
+	 * call for a name reads the frames, later ones return the same clip whatever their arguments
+	 */
+	AnimationHandle CreateClip(AssetName name, const SpriteSheet& sprite_sheet, float frames_per_second, bool loop = true);
+	[[nodiscard]] AnimationHandle FindClip(AssetName name) const;
+	[[nodiscard]] int GetClipFrameCount(AnimationHandle clip) const;
+	[[nodiscard]] float GetClipDuration(AnimationHandle clip) const;
+
+	AnimatorHandle CreateAnimator();
+	void DestroyAnimator(AnimatorHandle animator);
+	// switching to the clip already playing keeps its place, so turning around doesn't restart a run cycle
+	void Play(AnimatorHandle animator, AnimationHandle clip, float speed = 1.0f);
+	void SetSpeed(AnimatorHandle animator, float speed);
+	// true once a clip that doesn't loop has shown its last frame for its full duration
+	[[nodiscard]] bool IsFinished(AnimatorHandle animator) const;
+
+	// called by the game once a frame, advances every animator by delta_time seconds
+	void Update(float delta_time);
+
+	// the source rect to draw, null while the animator has no clip
+	[[nodiscard]] const SDL_Rect* GetFrameRect(AnimatorHandle animator) const;
+
+	[[nodiscard]] int GetAnimatorCount() const;
+
+private:
+	AnimationManager();
+	~AnimationManager();
+
+	struct AnimationClip
+	{
+		// into m_frameRects
+		uint32_t firstFrame = 0;
+		uint32_t frameCount = 0;
+		float frameDuration = 0.0f;
+		bool loop = true;
+	};
+
+	struct Animator
+	{
+		AnimationHandle clip;
+		float time = 0.0f;
+		float speed = 1.0f;
+		// the index into m_frameRects Update last settled on
+		uint32_t frame = 0;
+	};
+
+	AssetRegistry<AnimationTag, AnimationClip> m_clips;
+	std::vector<SDL_Rect> m_frameRects;
+
+	std::vector<Animator> m_animators;
+	// destroyed animators, reused before the array grows
+	std::vector<uint32_t> m_freeAnimators;
+};
+
+#endif /* defined (__ANIMATION_MANAGER__) */
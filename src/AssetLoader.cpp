@@ -0,0 +1,313 @@
+#include "AssetLoader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#include "FontManager.h"
+#include "TextureManager.h"
+
+namespace
+{
+	std::shared_ptr<const std::vector<char>> ReadFile(const std::string& file_name)
+	{
+		std::ifstream file(file_name, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return nullptr;
+		}
+
+		const auto size = file.tellg();
+		if (size <= 0)
+		{
+			return nullptr;
+		}
+
+		auto data = std::make_shared<std::vector<char>>(static_cast<size_t>(size));
+		file.seekg(0);
+		file.read(data->data(), size);
+		if (!file)
+		{
+			return nullptr;
+		}
+		return data;
+	}
+}
+
+AssetLoader::AssetLoader() :
+	m_generation(0), m_loading(false), m_running(false)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+	Shutdown();
+}
+
+void AssetLoader::Begin(const AssetManifest& manifest)
+{
+	Cancel();
+
+	m_manifest = manifest;
+	m_toDecode = AssetManifest{};
+	m_pendingTextures.clear();
+	m_loading = true;
+
+	// anything still loaded, such as the assets the current scene shares with the next, is not decoded again
+	auto& texture_manager = TextureManager::Instance();
+	for (const auto& texture : manifest.textures)
+	{
+		if (!texture_manager.IsLoaded(texture_manager.GetTextureHandle(texture.id)))
+		{
+			m_toDecode.textures.push_back(texture);
+			m_pendingTextures.push_back(texture_manager.LoadAsync(texture.fileName, texture.id));
+		}
+	}
+	for (const auto& sprite_sheet : manifest.spriteSheets)
+	{
+		// a packed atlas is only mapped here, the image is decoded along with the plain textures
+		if (texture_manager.GetSpriteSheet(sprite_sheet.name) == nullptr)
+		{
+			m_pendingTextures.push_back(texture_manager.LoadSpriteSheetAsync(sprite_sheet.dataFileName, sprite_sheet.textureFileName, sprite_sheet.name));
+		}
+	}
+	auto& font_manager = FontManager::Instance();
+	for (const auto& font : manifest.fonts)
+	{
+		if (font_manager.GetFont(font_manager.GetFontHandle(font.id)) == nullptr)
+		{
+			m_toDecode.fonts.push_back(font);
+		}
+	}
+
+	if (m_toDecode.fonts.empty())
+	{
+		m_decoded.emplace();
+		m_decoded->generation = m_generation;
+		return;
+	}
+
+	if (!m_running)
+	{
+		StartWorker();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_batches.push_back({ m_generation, m_toDecode });
+	}
+	m_batchCondition.notify_one();
+}
+
+void AssetLoader::Cancel()
+{
+	if (!m_loading)
+	{
+		return;
+	}
+
+	// a batch the worker has already started comes back under the old generation and is dropped
+	++m_generation;
+	m_loading = false;
+	m_decoded.reset();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_batches.clear();
+	m_results.clear();
+}
+
+bool AssetLoader::IsLoading() const
+{
+	return m_loading;
+}
+
+bool AssetLoader::IsReady()
+{
+	if (!m_loading)
+	{
+		return false;
+	}
+
+	// images are uploaded by the TextureManager, a failed one stops pending as well
+	auto& texture_manager = TextureManager::Instance();
+	for (const auto handle : m_pendingTextures)
+	{
+		if (texture_manager.IsPending(handle))
+		{
+			return false;
+		}
+	}
+
+	if (m_decoded.has_value())
+	{
+		return true;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	while (!m_results.empty())
+	{
+		auto decoded = std::move(m_results.front());
+		m_results.pop_front();
+		if (decoded.generation == m_generation)
+		{
+			m_decoded = std::move(decoded);
+		}
+	}
+	return m_decoded.has_value();
+}
+
+void AssetLoader::Wait()
+{
+	if (!m_loading)
+	{
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_decodedCondition.wait(lock, [this]
+		{
+			return m_decoded.has_value() || !m_running ||
+				std::any_of(m_results.begin(), m_results.end(), [this](const Decoded& decoded) { return decoded.generation == m_generation; });
+		});
+	}
+	TextureManager::Instance().FinishPendingLoads();
+}
+
+void AssetLoader::Commit()
+{
+	if (!IsReady())
+	{
+		return;
+	}
+
+	auto& font_manager = FontManager::Instance();
+	const auto& decoded = *m_decoded;
+
+	for (size_t i = 0; i < m_toDecode.fonts.size(); ++i)
+	{
+		const auto& font = m_toDecode.fonts[i];
+		if (!font_manager.LoadFromMemory(font_manager.GetFontHandle(font.id), decoded.fonts[i], font.size, font.style))
+		{
+			std::cout << "error loading font " << font.fileName << std::endl;
+		}
+	}
+
+	AddReferences(m_manifest);
+
+	m_decoded.reset();
+	m_loading = false;
+}
+
+void AssetLoader::AddReferences(const AssetManifest& manifest)
+{
+	auto& texture_manager = TextureManager::Instance();
+	for (const auto& texture : manifest.textures)
+	{
+		texture_manager.AddReference(texture_manager.GetTextureHandle(texture.id));
+	}
+	for (const auto& sprite_sheet : manifest.spriteSheets)
+	{
+		texture_manager.AddReference(texture_manager.GetTextureHandle(sprite_sheet.name));
+	}
+
+	auto& font_manager = FontManager::Instance();
+	for (const auto& font : manifest.fonts)
+	{
+		font_manager.AddReference(font_manager.GetFontHandle(font.id));
+	}
+}
+
+void AssetLoader::RemoveReferences(const AssetManifest& manifest)
+{
+	auto& texture_manager = TextureManager::Instance();
+	for (const auto& texture : manifest.textures)
+	{
+		texture_manager.RemoveReference(texture_manager.GetTextureHandle(texture.id));
+	}
+	for (const auto& sprite_sheet : manifest.spriteSheets)
+	{
+		texture_manager.RemoveReference(texture_manager.GetTextureHandle(sprite_sheet.name));
+	}
+
+	auto& font_manager = FontManager::Instance();
+	for (const auto& font : manifest.fonts)
+	{
+		font_manager.RemoveReference(font_manager.GetFontHandle(font.id));
+	}
+}
+
+void AssetLoader::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+		m_batches.clear();
+	}
+	m_batchCondition.notify_all();
+	m_decodedCondition.notify_all();
+
+	if (m_worker.joinable())
+	{
+		m_worker.join();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_results.clear();
+	}
+	m_decoded.reset();
+	m_loading = false;
+}
+
+AssetLoader::Decoded AssetLoader::Decode(const Batch& batch)
+{
+	Decoded decoded;
+	decoded.generation = batch.generation;
+
+	// SDL_ttf shares one FreeType library between every font and isn't safe to open fonts on two threads at
+	// once, so only the file is read here and the font is opened from memory on the main thread
+	for (const auto& font : batch.manifest.fonts)
+	{
+		decoded.fonts.push_back(ReadFile(font.fileName));
+	}
+
+	return decoded;
+}
+
+void AssetLoader::StartWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = true;
+	}
+
+	m_worker = std::thread(&AssetLoader::WorkerLoop, this);
+}
+
+void AssetLoader::WorkerLoop()
+{
+	while (true)
+	{
+		Batch batch;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_batchCondition.wait(lock, [this] { return !m_running || !m_batches.empty(); });
+			if (!m_running)
+			{
+				return;
+			}
+			batch = std::move(m_batches.front());
+			m_batches.pop_front();
+		}
+
+		auto decoded = Decode(batch);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_results.push_back(std::move(decoded));
+		}
+		m_decodedCondition.notify_all();
+	}
+}
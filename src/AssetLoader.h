@@ -0,0 +1,101 @@
+#pragma once
+#ifndef __ASSET_LOADER__
+#define __ASSET_LOADER__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "AssetManifest.h"
+#include "AssetRegistry.h"
+
+/* Singleton
+ * Loads a scene's AssetManifest in the background while the current scene keeps running. Images go to the
+ * TextureManager's decode workers and are uploaded under its per-frame budget, sprite sheet atlases are
+ * memory mapped up front. The loader's own thread reads font files, and Commit opens the fonts on the main
+ * thread, which is cheap enough to do in the frame the scene changes. Assets that are already loaded are
+ * referenced again, not reloaded.
+ */
+class AssetLoader
+{
+public:
+	static AssetLoader& Instance()
+	{
+		static AssetLoader instance;
+		return instance;
+	}
+
+	/*
+	 * Starts decoding whatever in the manifest isn't loaded yet. A load that is still in flight is
+	 * abandoned and its results are thrown away when they arrive
+	 */
+	void Begin(const AssetManifest& manifest);
+	void Cancel();
+
+	// true from Begin until Commit or Cancel
+	[[nodiscard]] bool IsLoading() const;
+	// true once every image Begin asked for is uploaded and the rest is waiting for Commit
+	[[nodiscard]] bool IsReady();
+	// blocks until IsReady, for when there is no scene to keep running in the meantime
+	void Wait();
+
+	/*
+	 * Main thread, once IsReady. Opens the fonts that were read and adds a reference to everything the
+	 * manifest lists, including assets that were loaded already
+	 */
+	void Commit();
+	// drops the references a Commit of the same manifest added
+	static void RemoveReferences(const AssetManifest& manifest);
+
+	// stops and joins the loader thread and drops any load in flight
+	void Shutdown();
+
+private:
+	AssetLoader();
+	~AssetLoader();
+
+	struct Batch
+	{
+		uint32_t generation;
+		AssetManifest manifest;
+	};
+
+	// one result per entry of the batch's manifest, in the same order, null when the entry failed
+	struct Decoded
+	{
+		uint32_t generation = 0;
+		std::vector<std::shared_ptr<const std::vector<char>>> fonts;
+	};
+
+	static void AddReferences(const AssetManifest& manifest);
+	static Decoded Decode(const Batch& batch);
+
+	void StartWorker();
+	void WorkerLoop();
+
+	// main thread only
+	AssetManifest m_manifest;
+	// the part of m_manifest that wasn't loaded when Begin was called
+	AssetManifest m_toDecode;
+	// handles of the images and sprite sheet images Begin started loading
+	std::vector<TextureHandle> m_pendingTextures;
+	std::optional<Decoded> m_decoded;
+	uint32_t m_generation;
+	bool m_loading;
+
+	std::thread m_worker;
+	bool m_running;
+
+	std::mutex m_mutex;
+	std::condition_variable m_batchCondition;
+	std::condition_variable m_decodedCondition;
+	std::deque<Batch> m_batches;
+	std::deque<Decoded> m_results;
+};
+
+#endif /* defined (__ASSET_LOADER__) */
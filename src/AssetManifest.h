@@ -0,0 +1,62 @@
+#pragma once
+#ifndef __ASSET_MANIFEST__
+#define __ASSET_MANIFEST__
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL_ttf.h>
+
+/*
+ * Everything a scene loads when it starts, declared up front so the AssetLoader can decode it in the
+ * background while the previous scene is still running. The ids are the same ones the scene's objects
+ * pass to the managers, so their own Load calls find the assets already resident
+ */
+struct AssetManifest
+{
+	struct Texture
+	{
+		std::string fileName;
+		std::string id;
+	};
+
+	struct SpriteSheet
+	{
+		std::string dataFileName;
+		std::string textureFileName;
+		std::string name;
+	};
+
+	struct Font
+	{
+		std::string fileName;
+		std::string id;
+		int size;
+		int style;
+	};
+
+	AssetManifest& AddTexture(std::string file_name, std::string id)
+	{
+		textures.push_back({ std::move(file_name), std::move(id) });
+		return *this;
+	}
+
+	AssetManifest& AddSpriteSheet(std::string data_file_name, std::string texture_file_name, std::string sprite_sheet_name)
+	{
+		spriteSheets.push_back({ std::move(data_file_name), std::move(texture_file_name), std::move(sprite_sheet_name) });
+		return *this;
+	}
+
+	AssetManifest& AddFont(std::string file_name, std::string id, const int size, const int style = TTF_STYLE_NORMAL)
+	{
+		fonts.push_back({ std::move(file_name), std::move(id), size, style });
+		return *this;
+	}
+
+	std::vector<Texture> textures;
+	std::vector<SpriteSheet> spriteSheets;
+	std::vector<Font> fonts;
+};
+
+#endif /* defined (__ASSET_MANIFEST__) */
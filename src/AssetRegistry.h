@@ -0,0 +1,209 @@
+#pragma once
+#ifndef __ASSET_REGISTRY__
+#define __ASSET_REGISTRY__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Name of an asset together with its FNV-1a hash. The hash is only guaranteed to be worked out at compile
+ * time when the name is constant evaluated, as in constexpr AssetName name = "megaman-run". A literal passed
+ * straight to a function may still be hashed at run time, depending on how the compiler optimises it
+ */
+struct AssetName
+{
+	constexpr AssetName(const char* name) : text(name), hash(Hash(text))
+	{
+	}
+
+	AssetName(const std::string& name) : text(name), hash(Hash(text))
+	{
+	}
+
+	static constexpr uint32_t Hash(const std::string_view name)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char character : name)
+		{
+			hash = (hash ^ static_cast<uint8_t>(character)) * 16777619u;
+		}
+		return hash;
+	}
+
+	std::string_view text;
+	uint32_t hash;
+};
+
+/*
+ * Compact index of an interned asset. The tag keeps a texture handle from being passed where a sound is
+ * expected. A handle stays valid for the life of its registry, even while the asset it names is unloaded
+ */
+template <typename Tag>
+struct AssetHandle
+{
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	uint32_t index = INVALID_INDEX;
+
+	[[nodiscard]] bool IsValid() const { return index != INVALID_INDEX; }
+	bool operator==(const AssetHandle other) const { return index == other.index; }
+	bool operator!=(const AssetHandle other) const { return index != other.index; }
+};
+
+struct TextureTag {};
+struct FontTag {};
+struct SoundTag {};
+struct MusicTag {};
+struct AnimationTag {};
+
+using TextureHandle = AssetHandle<TextureTag>;
+using FontHandle = AssetHandle<FontTag>;
+using SoundHandle = AssetHandle<SoundTag>;
+using MusicHandle = AssetHandle<MusicTag>;
+using AnimationHandle = AssetHandle<AnimationTag>;
+
+/*
+ * Interns names into dense handles and keeps one Entry per handle in a flat array, so anything that holds
+ * on to a handle reaches its asset with a single index. Names are only looked at when interning.
+ * Entry must be default constructible, and a default constructed Entry means "not loaded"
+ */
+template <typename Tag, typename Entry>
+class AssetRegistry
+{
+public:
+	using Handle = AssetHandle<Tag>;
+
+	// the handle for name, reserving an empty slot the first time a name is seen
+	Handle Intern(const AssetName name)
+	{
+		// hash collisions probe the following keys, names are never removed so the chains never break
+		for (uint32_t key = name.hash; ; ++key)
+		{
+			const auto it = m_indexByKey.find(key);
+			if (it == m_indexByKey.end())
+			{
+				const auto index = static_cast<uint32_t>(m_entries.size());
+				m_indexByKey.emplace(key, index);
+				m_entries.emplace_back();
+				m_names.emplace_back(name.text);
+				m_loaded.push_back(0);
+				m_references.push_back(0);
+				return Handle{ index };
+			}
+			if (m_names[it->second] == name.text)
+			{
+				return Handle{ it->second };
+			}
+		}
+	}
+
+	// the handle for name, or an invalid one when the name was never interned
+	[[nodiscard]] Handle Find(const AssetName name) const
+	{
+		for (uint32_t key = name.hash; ; ++key)
+		{
+			const auto it = m_indexByKey.find(key);
+			if (it == m_indexByKey.end())
+			{
+				return Handle{};
+			}
+			if (m_names[it->second] == name.text)
+			{
+				return Handle{ it->second };
+			}
+		}
+	}
+
+	void Set(const Handle handle, Entry entry)
+	{
+		m_entries[handle.index] = std::move(entry);
+		m_loaded[handle.index] = 1;
+	}
+
+	// back to an empty slot, the handle itself stays reserved for the name
+	void Reset(const Handle handle)
+	{
+		m_entries[handle.index] = Entry{};
+		m_loaded[handle.index] = 0;
+	}
+
+	[[nodiscard]] bool IsLoaded(const Handle handle) const
+	{
+		return handle.index < m_loaded.size() && m_loaded[handle.index] != 0;
+	}
+
+	Entry& Get(const Handle handle)
+	{
+		return m_entries[handle.index];
+	}
+
+	[[nodiscard]] const Entry& Get(const Handle handle) const
+	{
+		return m_entries[handle.index];
+	}
+
+	[[nodiscard]] const std::string& GetName(const Handle handle) const
+	{
+		return m_names[handle.index];
+	}
+
+	// empties every slot, handles handed out so far keep naming the same assets
+	void ResetAll()
+	{
+		for (uint32_t index = 0; index < m_entries.size(); ++index)
+		{
+			Reset(Handle{ index });
+		}
+	}
+
+	[[nodiscard]] int GetLoadedCount() const
+	{
+		int count = 0;
+		for (const auto loaded : m_loaded)
+		{
+			count += loaded;
+		}
+		return count;
+	}
+
+	/*
+	 * Counts whoever needs the asset to stay loaded, such as the manifests of the current and the next scene.
+	 * Counting alone never unloads anything, the owning manager drops unreferenced assets when it is told to
+	 */
+	void AddReference(const Handle handle)
+	{
+		++m_references[handle.index];
+	}
+
+	void RemoveReference(const Handle handle)
+	{
+		if (m_references[handle.index] > 0)
+		{
+			--m_references[handle.index];
+		}
+	}
+
+	[[nodiscard]] int GetReferenceCount(const Handle handle) const
+	{
+		return m_references[handle.index];
+	}
+
+	// every interned slot, loaded or not
+	[[nodiscard]] uint32_t GetSlotCount() const
+	{
+		return static_cast<uint32_t>(m_entries.size());
+	}
+
+private:
+	std::vector<Entry> m_entries;
+	std::vector<std::string> m_names;
+	std::vector<uint8_t> m_loaded;
+	std::vector<int> m_references;
+	std::unordered_map<uint32_t, uint32_t> m_indexByKey;
+};
+
+#endif /* defined (__ASSET_REGISTRY__) */
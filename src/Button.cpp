@@ -19,8 +19,9 @@ Button::Button(const std::string& image_path, std::string button_name, const Gam
 m_alpha(255), m_name(std::move(button_name)), m_isCentered(is_centered), m_active(true)
 {
 	TextureManager::Instance().Load(image_path,m_name);
+	m_texture = TextureManager::Instance().GetTextureHandle(m_name);
 
-	const auto size = TextureManager::Instance().GetTextureSize(m_name);
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 	GetTransform()->position = position;
@@ -33,7 +34,7 @@ Button::~Button()
 void Button::Draw()
 {
 	// draw the button
-	TextureManager::Instance().Draw(m_name, GetTransform()->position, 0, m_alpha, m_isCentered);
+	TextureManager::Instance().Draw(m_texture, GetTransform()->position, 0, m_alpha, m_isCentered);
 }
 
 void Button::Update()
@@ -2,6 +2,7 @@
 #ifndef __BUTTON__
 #define __BUTTON__
 
+#include "AssetRegistry.h"
 #include "DisplayObject.h"
 #include <SDL.h>
 #include "UIControl.h"
@@ -28,6 +29,7 @@ public:
 private:
 	Uint8 m_alpha;
 	std::string m_name;
+	TextureHandle m_texture;
 	bool m_isCentered;
 	bool m_active;
 };
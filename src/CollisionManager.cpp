@@ -2,6 +2,49 @@
 #include "Util.h"
 #include <algorithm>
 
+// pick the widest instruction set the build targets, the batch checks finish any remainder with scalar code
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COLLISION_USE_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISION_USE_SSE2
+#endif
+
+namespace
+{
+	// interned on first use, handles stay valid whether or not the sound has been loaded yet
+	SoundHandle YaySound()
+	{
+		static const auto handle = SoundManager::Instance().GetSoundHandle("yay");
+		return handle;
+	}
+
+	SoundHandle ThunderSound()
+	{
+		static const auto handle = SoundManager::Instance().GetSoundHandle("thunder");
+		return handle;
+	}
+
+	// appends base + the index of every set bit in the lane mask
+	int AppendHits(int mask, const int base, std::vector<int>& hits)
+	{
+		int appended = 0;
+		while (mask != 0)
+		{
+			int lane = 0;
+			while ((mask & (1 << lane)) == 0)
+			{
+				++lane;
+			}
+			hits.push_back(base + lane);
+			mask &= mask - 1;
+			++appended;
+		}
+		return appended;
+	}
+}
 
 
 int CollisionManager::SquaredDistance(const glm::vec2 p1, const glm::vec2 p2)
@@ -27,7 +70,7 @@ bool CollisionManager::SquaredRadiusCheck(GameObject* object1, GameObject* objec
 			switch (object2->GetType()) {
 			case GameObjectType::TARGET:
 				std::cout << "Collision with Target!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
+				SoundManager::Instance().PlaySound(YaySound(), 0);
 
 				break;
 			default:
@@ -69,11 +112,11 @@ bool CollisionManager::AABBCheck(GameObject* object1, GameObject* object2)
 			switch (object2->GetType()) {
 			case GameObjectType::TARGET:
 				std::cout << "Collision with Target!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
+				SoundManager::Instance().PlaySound(YaySound(), 0);
 				break;
 			case GameObjectType::OBSTACLE:
 				std::cout << "Collision with Obstacle!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
+				SoundManager::Instance().PlaySound(YaySound(), 0);
 				break;
 			default:
 
@@ -233,7 +276,7 @@ bool CollisionManager::LineAABBCheck(Ship* object1, GameObject* object2)
 		{
 		case GameObjectType::TARGET:
 			std::cout << "Collision with Obstacle!" << std::endl;
-			SoundManager::Instance().PlaySound("yay", 0);
+			SoundManager::Instance().PlaySound(YaySound(), 0);
 
 			break;
 		default:
@@ -286,11 +329,11 @@ bool CollisionManager::CircleAABBCheck(GameObject* object1, GameObject* object2)
 			{
 			case GameObjectType::TARGET:
 				std::cout << "Collision with Planet!" << std::endl;
-				SoundManager::Instance().PlaySound("yay", 0);
+				SoundManager::Instance().PlaySound(YaySound(), 0);
 				break;
 			case GameObjectType::SHIP:
 			{
-				SoundManager::Instance().PlaySound("thunder", 0);
+				SoundManager::Instance().PlaySound(ThunderSound(), 0);
 				const auto velocity_x = object1->GetRigidBody()->velocity.x;
 				const auto velocity_y = object1->GetRigidBody()->velocity.y;
 
@@ -322,7 +365,7 @@ bool CollisionManager::CircleAABBCheck(GameObject* object1, GameObject* object2)
 			}
 			case GameObjectType::AGENT:
 			{
-				SoundManager::Instance().PlaySound("yay", 0);
+				SoundManager::Instance().PlaySound(YaySound(), 0);
 			}
 			break;
 			default:
@@ -394,15 +437,12 @@ bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const s
 				}
 				break;
 			default:
-				//error
-				std::cout << "ERROR: " << static_cast<int>(agent->GetType()) << std::endl;
 				break;
 			}
 		}
 		break;
 		default:
-			//error
-			std::cout << "ERROR: " << static_cast<int>(object->GetType()) << std::endl;
+			// other objects neither block nor complete the line of sight
 			break;
 		}
 
@@ -412,6 +452,29 @@ bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const s
 	return false;
 }
 
+bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const ObstacleGrid& obstacles, DisplayObject* target)
+{
+	const auto start_point = agent->GetTransform()->position;
+
+	// only the obstacles in the grid cells the line crosses are tested
+	if (obstacles.SegmentBlocked(start_point, end_point))
+	{
+		return false;
+	}
+
+	const auto width = static_cast<float>(target->GetWidth());
+	const auto height = static_cast<float>(target->GetHeight());
+	const auto rect_start = target->GetTransform()->position - glm::vec2(width * 0.5f, height * 0.5f);
+
+	switch (agent->GetType())
+	{
+	case GameObjectType::PATH_NODE:
+		return LineRectEdgeCheck(start_point, rect_start, width, height);
+	default:
+		return LineRectCheck(start_point, end_point, rect_start, width, height);
+	}
+}
+
 void CollisionManager::RotateAABB(GameObject* object1, const float angle)
 {
 	// create an array of vec2s using right winding order (TL, TR, BR, BL)
@@ -482,6 +545,405 @@ void CollisionManager::RotateAABB(GameObject* object1, const float angle)
 }
 
 
+void PackedAABBs::Add(const glm::vec2 box_min, const glm::vec2 box_max)
+{
+	minX.push_back(box_min.x);
+	minY.push_back(box_min.y);
+	maxX.push_back(box_max.x);
+	maxY.push_back(box_max.y);
+}
+
+void PackedAABBs::Clear()
+{
+	minX.clear();
+	minY.clear();
+	maxX.clear();
+	maxY.clear();
+}
+
+int PackedAABBs::Size() const
+{
+	return static_cast<int>(minX.size());
+}
+
+void PackedCircles::Add(const glm::vec2 centre, const float circle_radius)
+{
+	centreX.push_back(centre.x);
+	centreY.push_back(centre.y);
+	radius.push_back(circle_radius);
+}
+
+void PackedCircles::Clear()
+{
+	centreX.clear();
+	centreY.clear();
+	radius.clear();
+}
+
+int PackedCircles::Size() const
+{
+	return static_cast<int>(centreX.size());
+}
+
+int CollisionManager::AABBBatchCheck(const glm::vec2 box_min, const glm::vec2 box_max, const PackedAABBs& boxes, std::vector<int>& hits)
+{
+	const int count = boxes.Size();
+	int appended = 0;
+	int i = 0;
+
+#ifdef COLLISION_USE_AVX2
+	{
+		const __m256 q_min_x = _mm256_set1_ps(box_min.x);
+		const __m256 q_min_y = _mm256_set1_ps(box_min.y);
+		const __m256 q_max_x = _mm256_set1_ps(box_max.x);
+		const __m256 q_max_y = _mm256_set1_ps(box_max.y);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 hit_x = _mm256_and_ps(
+				_mm256_cmp_ps(q_min_x, _mm256_loadu_ps(&boxes.maxX[i]), _CMP_LT_OQ),
+				_mm256_cmp_ps(q_max_x, _mm256_loadu_ps(&boxes.minX[i]), _CMP_GT_OQ));
+			const __m256 hit_y = _mm256_and_ps(
+				_mm256_cmp_ps(q_min_y, _mm256_loadu_ps(&boxes.maxY[i]), _CMP_LT_OQ),
+				_mm256_cmp_ps(q_max_y, _mm256_loadu_ps(&boxes.minY[i]), _CMP_GT_OQ));
+			appended += AppendHits(_mm256_movemask_ps(_mm256_and_ps(hit_x, hit_y)), i, hits);
+		}
+	}
+#endif
+#ifdef COLLISION_USE_SSE2
+	{
+		const __m128 q_min_x = _mm_set1_ps(box_min.x);
+		const __m128 q_min_y = _mm_set1_ps(box_min.y);
+		const __m128 q_max_x = _mm_set1_ps(box_max.x);
+		const __m128 q_max_y = _mm_set1_ps(box_max.y);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 hit_x = _mm_and_ps(
+				_mm_cmplt_ps(q_min_x, _mm_loadu_ps(&boxes.maxX[i])),
+				_mm_cmpgt_ps(q_max_x, _mm_loadu_ps(&boxes.minX[i])));
+			const __m128 hit_y = _mm_and_ps(
+				_mm_cmplt_ps(q_min_y, _mm_loadu_ps(&boxes.maxY[i])),
+				_mm_cmpgt_ps(q_max_y, _mm_loadu_ps(&boxes.minY[i])));
+			appended += AppendHits(_mm_movemask_ps(_mm_and_ps(hit_x, hit_y)), i, hits);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if (box_min.x < boxes.maxX[i] && box_max.x > boxes.minX[i] &&
+			box_min.y < boxes.maxY[i] && box_max.y > boxes.minY[i])
+		{
+			hits.push_back(i);
+			++appended;
+		}
+	}
+	return appended;
+}
+
+int CollisionManager::PointAABBBatchCheck(const glm::vec2 point, const PackedAABBs& boxes, std::vector<int>& hits)
+{
+	const int count = boxes.Size();
+	int appended = 0;
+	int i = 0;
+
+#ifdef COLLISION_USE_AVX2
+	{
+		const __m256 p_x = _mm256_set1_ps(point.x);
+		const __m256 p_y = _mm256_set1_ps(point.y);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 hit_x = _mm256_and_ps(
+				_mm256_cmp_ps(p_x, _mm256_loadu_ps(&boxes.minX[i]), _CMP_GT_OQ),
+				_mm256_cmp_ps(p_x, _mm256_loadu_ps(&boxes.maxX[i]), _CMP_LT_OQ));
+			const __m256 hit_y = _mm256_and_ps(
+				_mm256_cmp_ps(p_y, _mm256_loadu_ps(&boxes.minY[i]), _CMP_GT_OQ),
+				_mm256_cmp_ps(p_y, _mm256_loadu_ps(&boxes.maxY[i]), _CMP_LT_OQ));
+			appended += AppendHits(_mm256_movemask_ps(_mm256_and_ps(hit_x, hit_y)), i, hits);
+		}
+	}
+#endif
+#ifdef COLLISION_USE_SSE2
+	{
+		const __m128 p_x = _mm_set1_ps(point.x);
+		const __m128 p_y = _mm_set1_ps(point.y);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 hit_x = _mm_and_ps(
+				_mm_cmpgt_ps(p_x, _mm_loadu_ps(&boxes.minX[i])),
+				_mm_cmplt_ps(p_x, _mm_loadu_ps(&boxes.maxX[i])));
+			const __m128 hit_y = _mm_and_ps(
+				_mm_cmpgt_ps(p_y, _mm_loadu_ps(&boxes.minY[i])),
+				_mm_cmplt_ps(p_y, _mm_loadu_ps(&boxes.maxY[i])));
+			appended += AppendHits(_mm_movemask_ps(_mm_and_ps(hit_x, hit_y)), i, hits);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if (point.x > boxes.minX[i] && point.x < boxes.maxX[i] &&
+			point.y > boxes.minY[i] && point.y < boxes.maxY[i])
+		{
+			hits.push_back(i);
+			++appended;
+		}
+	}
+	return appended;
+}
+
+int CollisionManager::CircleAABBBatchCheck(const glm::vec2 circle_centre, const float circle_radius, const PackedAABBs& boxes, std::vector<int>& hits)
+{
+	const int count = boxes.Size();
+	const float squared_radius = circle_radius * circle_radius;
+	int appended = 0;
+	int i = 0;
+
+	// distance from the centre to the closest point of each box, compared without a square root
+#ifdef COLLISION_USE_AVX2
+	{
+		const __m256 c_x = _mm256_set1_ps(circle_centre.x);
+		const __m256 c_y = _mm256_set1_ps(circle_centre.y);
+		const __m256 r2 = _mm256_set1_ps(squared_radius);
+		const __m256 zero = _mm256_setzero_ps();
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.minX[i]), c_x), zero),
+				_mm256_sub_ps(c_x, _mm256_loadu_ps(&boxes.maxX[i])));
+			const __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.minY[i]), c_y), zero),
+				_mm256_sub_ps(c_y, _mm256_loadu_ps(&boxes.maxY[i])));
+			const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			appended += AppendHits(_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LE_OQ)), i, hits);
+		}
+	}
+#endif
+#ifdef COLLISION_USE_SSE2
+	{
+		const __m128 c_x = _mm_set1_ps(circle_centre.x);
+		const __m128 c_y = _mm_set1_ps(circle_centre.y);
+		const __m128 r2 = _mm_set1_ps(squared_radius);
+		const __m128 zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.minX[i]), c_x), zero),
+				_mm_sub_ps(c_x, _mm_loadu_ps(&boxes.maxX[i])));
+			const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.minY[i]), c_y), zero),
+				_mm_sub_ps(c_y, _mm_loadu_ps(&boxes.maxY[i])));
+			const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			appended += AppendHits(_mm_movemask_ps(_mm_cmple_ps(d2, r2)), i, hits);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const float dx = std::max(std::max(boxes.minX[i] - circle_centre.x, 0.0f), circle_centre.x - boxes.maxX[i]);
+		const float dy = std::max(std::max(boxes.minY[i] - circle_centre.y, 0.0f), circle_centre.y - boxes.maxY[i]);
+		if (dx * dx + dy * dy <= squared_radius)
+		{
+			hits.push_back(i);
+			++appended;
+		}
+	}
+	return appended;
+}
+
+int CollisionManager::CircleCircleBatchCheck(const glm::vec2 circle_centre, const float circle_radius, const PackedCircles& circles, std::vector<int>& hits)
+{
+	const int count = circles.Size();
+	int appended = 0;
+	int i = 0;
+
+#ifdef COLLISION_USE_AVX2
+	{
+		const __m256 c_x = _mm256_set1_ps(circle_centre.x);
+		const __m256 c_y = _mm256_set1_ps(circle_centre.y);
+		const __m256 r = _mm256_set1_ps(circle_radius);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&circles.centreX[i]), c_x);
+			const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&circles.centreY[i]), c_y);
+			const __m256 radii = _mm256_add_ps(_mm256_loadu_ps(&circles.radius[i]), r);
+			const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+			appended += AppendHits(_mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_mul_ps(radii, radii), _CMP_LT_OQ)), i, hits);
+		}
+	}
+#endif
+#ifdef COLLISION_USE_SSE2
+	{
+		const __m128 c_x = _mm_set1_ps(circle_centre.x);
+		const __m128 c_y = _mm_set1_ps(circle_centre.y);
+		const __m128 r = _mm_set1_ps(circle_radius);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&circles.centreX[i]), c_x);
+			const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&circles.centreY[i]), c_y);
+			const __m128 radii = _mm_add_ps(_mm_loadu_ps(&circles.radius[i]), r);
+			const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+			appended += AppendHits(_mm_movemask_ps(_mm_cmplt_ps(d2, _mm_mul_ps(radii, radii))), i, hits);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		const float dx = circles.centreX[i] - circle_centre.x;
+		const float dy = circles.centreY[i] - circle_centre.y;
+		const float radii = circles.radius[i] + circle_radius;
+		if (dx * dx + dy * dy < radii * radii)
+		{
+			hits.push_back(i);
+			++appended;
+		}
+	}
+	return appended;
+}
+
+bool CollisionManager::LineAABBSlabCheck(const glm::vec2 line_start, const glm::vec2 line_end, const glm::vec2 box_min, const glm::vec2 box_max)
+{
+	// clip the segment's parameter range [0, 1] against the x slab and then the y slab
+	const auto direction = line_end - line_start;
+	float t_enter = 0.0f;
+	float t_exit = 1.0f;
+
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (std::abs(direction[axis]) < Util::EPSILON)
+		{
+			// parallel to this slab, so it has to start inside it
+			if (line_start[axis] < box_min[axis] || line_start[axis] > box_max[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const float inverse = 1.0f / direction[axis];
+		const float t1 = (box_min[axis] - line_start[axis]) * inverse;
+		const float t2 = (box_max[axis] - line_start[axis]) * inverse;
+		t_enter = std::max(t_enter, std::min(t1, t2));
+		t_exit = std::min(t_exit, std::max(t1, t2));
+		if (t_enter > t_exit)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int CollisionManager::LineAABBBatchCheck(const glm::vec2 line_start, const glm::vec2 line_end, const PackedAABBs& boxes, std::vector<int>& hits)
+{
+	const int count = boxes.Size();
+	const auto direction = line_end - line_start;
+	const bool parallel_x = std::abs(direction.x) < Util::EPSILON;
+	const bool parallel_y = std::abs(direction.y) < Util::EPSILON;
+	// the divisions happen once per segment instead of once per box
+	const float inverse_x = parallel_x ? 0.0f : 1.0f / direction.x;
+	const float inverse_y = parallel_y ? 0.0f : 1.0f / direction.y;
+	int appended = 0;
+	int i = 0;
+
+#ifdef COLLISION_USE_AVX2
+	{
+		const __m256 s_x = _mm256_set1_ps(line_start.x);
+		const __m256 s_y = _mm256_set1_ps(line_start.y);
+		const __m256 inv_x = _mm256_set1_ps(inverse_x);
+		const __m256 inv_y = _mm256_set1_ps(inverse_y);
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m256 min_x = _mm256_loadu_ps(&boxes.minX[i]);
+			const __m256 max_x = _mm256_loadu_ps(&boxes.maxX[i]);
+			const __m256 min_y = _mm256_loadu_ps(&boxes.minY[i]);
+			const __m256 max_y = _mm256_loadu_ps(&boxes.maxY[i]);
+			__m256 t_enter = _mm256_setzero_ps();
+			__m256 t_exit = _mm256_set1_ps(1.0f);
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			if (parallel_x)
+			{
+				inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(s_x, min_x, _CMP_GE_OQ), _mm256_cmp_ps(s_x, max_x, _CMP_LE_OQ)));
+			}
+			else
+			{
+				const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(min_x, s_x), inv_x);
+				const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(max_x, s_x), inv_x);
+				t_enter = _mm256_max_ps(t_enter, _mm256_min_ps(t1, t2));
+				t_exit = _mm256_min_ps(t_exit, _mm256_max_ps(t1, t2));
+			}
+
+			if (parallel_y)
+			{
+				inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(s_y, min_y, _CMP_GE_OQ), _mm256_cmp_ps(s_y, max_y, _CMP_LE_OQ)));
+			}
+			else
+			{
+				const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(min_y, s_y), inv_y);
+				const __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(max_y, s_y), inv_y);
+				t_enter = _mm256_max_ps(t_enter, _mm256_min_ps(t1, t2));
+				t_exit = _mm256_min_ps(t_exit, _mm256_max_ps(t1, t2));
+			}
+
+			const __m256 hit = _mm256_and_ps(inside, _mm256_cmp_ps(t_enter, t_exit, _CMP_LE_OQ));
+			appended += AppendHits(_mm256_movemask_ps(hit), i, hits);
+		}
+	}
+#endif
+#ifdef COLLISION_USE_SSE2
+	{
+		const __m128 s_x = _mm_set1_ps(line_start.x);
+		const __m128 s_y = _mm_set1_ps(line_start.y);
+		const __m128 inv_x = _mm_set1_ps(inverse_x);
+		const __m128 inv_y = _mm_set1_ps(inverse_y);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 min_x = _mm_loadu_ps(&boxes.minX[i]);
+			const __m128 max_x = _mm_loadu_ps(&boxes.maxX[i]);
+			const __m128 min_y = _mm_loadu_ps(&boxes.minY[i]);
+			const __m128 max_y = _mm_loadu_ps(&boxes.maxY[i]);
+			__m128 t_enter = _mm_setzero_ps();
+			__m128 t_exit = _mm_set1_ps(1.0f);
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			if (parallel_x)
+			{
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(s_x, min_x), _mm_cmple_ps(s_x, max_x)));
+			}
+			else
+			{
+				const __m128 t1 = _mm_mul_ps(_mm_sub_ps(min_x, s_x), inv_x);
+				const __m128 t2 = _mm_mul_ps(_mm_sub_ps(max_x, s_x), inv_x);
+				t_enter = _mm_max_ps(t_enter, _mm_min_ps(t1, t2));
+				t_exit = _mm_min_ps(t_exit, _mm_max_ps(t1, t2));
+			}
+
+			if (parallel_y)
+			{
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(s_y, min_y), _mm_cmple_ps(s_y, max_y)));
+			}
+			else
+			{
+				const __m128 t1 = _mm_mul_ps(_mm_sub_ps(min_y, s_y), inv_y);
+				const __m128 t2 = _mm_mul_ps(_mm_sub_ps(max_y, s_y), inv_y);
+				t_enter = _mm_max_ps(t_enter, _mm_min_ps(t1, t2));
+				t_exit = _mm_min_ps(t_exit, _mm_max_ps(t1, t2));
+			}
+
+			const __m128 hit = _mm_and_ps(inside, _mm_cmple_ps(t_enter, t_exit));
+			appended += AppendHits(_mm_movemask_ps(hit), i, hits);
+		}
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		if (LineAABBSlabCheck(line_start, line_end, glm::vec2(boxes.minX[i], boxes.minY[i]), glm::vec2(boxes.maxX[i], boxes.maxY[i])))
+		{
+			hits.push_back(i);
+			++appended;
+		}
+	}
+	return appended;
+}
+
 CollisionManager::CollisionManager()
 = default;
 
@@ -4,11 +4,38 @@
 
 // core libraries
 #include <iostream>
+#include <vector>
 
 #include "GameObject.h"
 #include "Ship.h"
 #include <glm/gtx/norm.hpp>
 #include "SoundManager.h"
+#include "ObstacleGrid.h"
+
+// boxes stored as separate component arrays so the batch checks can test four or eight at a time
+struct PackedAABBs
+{
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+
+	void Add(glm::vec2 box_min, glm::vec2 box_max);
+	void Clear();
+	[[nodiscard]] int Size() const;
+};
+
+// circles stored as separate component arrays for the batch checks
+struct PackedCircles
+{
+	std::vector<float> centreX;
+	std::vector<float> centreY;
+	std::vector<float> radius;
+
+	void Add(glm::vec2 centre, float circle_radius);
+	void Clear();
+	[[nodiscard]] int Size() const;
+};
 
 class CollisionManager
 {
@@ -32,9 +59,24 @@ public:
 	static bool PointRectCheck(glm::vec2 point, glm::vec2 rect_start, float rect_width, float rect_height);
 
 	static bool LOSCheck(Agent* agent, glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target);
+	// same check against a prebuilt obstacle grid, the cost depends on the length of the line rather than the number of obstacles
+	static bool LOSCheck(Agent* agent, glm::vec2 end_point, const ObstacleGrid& obstacles, DisplayObject* target);
 
 	static void RotateAABB(GameObject* object1, float angle);
 
+	/*
+	 * One-versus-many checks. Each one tests a single shape against every entry of a packed array and
+	 * appends the indices it hits to hits (which is not cleared), returning how many it appended.
+	 * They use AVX2 or SSE2 when the build targets them and fall back to scalar code otherwise
+	 */
+	static int AABBBatchCheck(glm::vec2 box_min, glm::vec2 box_max, const PackedAABBs& boxes, std::vector<int>& hits);
+	static int PointAABBBatchCheck(glm::vec2 point, const PackedAABBs& boxes, std::vector<int>& hits);
+	static int CircleAABBBatchCheck(glm::vec2 circle_centre, float circle_radius, const PackedAABBs& boxes, std::vector<int>& hits);
+	static int CircleCircleBatchCheck(glm::vec2 circle_centre, float circle_radius, const PackedCircles& circles, std::vector<int>& hits);
+	// slab test, a segment that starts or ends inside a box counts as a hit
+	static int LineAABBBatchCheck(glm::vec2 line_start, glm::vec2 line_end, const PackedAABBs& boxes, std::vector<int>& hits);
+	static bool LineAABBSlabCheck(glm::vec2 line_start, glm::vec2 line_end, glm::vec2 box_min, glm::vec2 box_max);
+
 private:
 	CollisionManager();
 	~CollisionManager();
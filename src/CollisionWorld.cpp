@@ -0,0 +1,479 @@
+#include "CollisionWorld.h"
+
+#include <algorithm>
+
+#include "ComponentStore.h"
+
+namespace
+{
+	bool Overlaps(const glm::vec2 a_min, const glm::vec2 a_max, const glm::vec2 b_min, const glm::vec2 b_max)
+	{
+		return a_min.x < b_max.x && a_max.x > b_min.x && a_min.y < b_max.y && a_max.y > b_min.y;
+	}
+
+	bool BoxContains(const glm::vec2 outer_min, const glm::vec2 outer_max, const glm::vec2 inner_min, const glm::vec2 inner_max)
+	{
+		return outer_min.x <= inner_min.x && outer_min.y <= inner_min.y && inner_max.x <= outer_max.x && inner_max.y <= outer_max.y;
+	}
+
+	// in 2D the perimeter plays the role of the surface area heuristic
+	float Perimeter(const glm::vec2 box_min, const glm::vec2 box_max)
+	{
+		return 2.0f * ((box_max.x - box_min.x) + (box_max.y - box_min.y));
+	}
+
+	uint64_t PairKey(const int proxy_a, const int proxy_b)
+	{
+		return (static_cast<uint64_t>(std::min(proxy_a, proxy_b)) << 32) | static_cast<uint32_t>(std::max(proxy_a, proxy_b));
+	}
+}
+
+CollisionWorld::CollisionWorld() : m_root(NULL_NODE), m_freeNode(NULL_NODE)
+{
+}
+
+CollisionWorld::~CollisionWorld()
+= default;
+
+void CollisionWorld::Add(GameObject* object)
+{
+	if (object == nullptr || Contains(object))
+	{
+		return;
+	}
+
+	int proxy;
+	if (!m_freeProxies.empty())
+	{
+		proxy = m_freeProxies.back();
+		m_freeProxies.pop_back();
+	}
+	else
+	{
+		proxy = static_cast<int>(m_proxies.size());
+		m_proxies.emplace_back();
+	}
+
+	m_proxies[proxy] = { object, NULL_NODE, glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f) };
+	m_proxyByObject[object] = proxy;
+}
+
+void CollisionWorld::Remove(GameObject* object)
+{
+	const auto it = m_proxyByObject.find(object);
+	if (it == m_proxyByObject.end())
+	{
+		return;
+	}
+
+	auto& proxy = m_proxies[it->second];
+	if (proxy.node != NULL_NODE)
+	{
+		RemoveLeaf(proxy.node);
+		FreeNode(proxy.node);
+		proxy.node = NULL_NODE;
+	}
+	proxy.object = nullptr;
+
+	// the id is recycled once Update has dropped the contacts that still refer to it
+	m_deadProxies.push_back(it->second);
+	m_proxyByObject.erase(it);
+}
+
+void CollisionWorld::Clear()
+{
+	m_nodes.clear();
+	m_root = NULL_NODE;
+	m_freeNode = NULL_NODE;
+	m_proxies.clear();
+	m_freeProxies.clear();
+	m_deadProxies.clear();
+	m_proxyByObject.clear();
+	m_moved.clear();
+	m_contacts.clear();
+	m_events.clear();
+}
+
+bool CollisionWorld::Contains(GameObject* object) const
+{
+	return m_proxyByObject.find(object) != m_proxyByObject.end();
+}
+
+void CollisionWorld::Update()
+{
+	m_events.clear();
+	m_moved.clear();
+
+	// refresh every box, only objects that left their fat box touch the tree
+	auto& store = ComponentStore::Instance();
+	for (int i = 0; i < static_cast<int>(m_proxies.size()); ++i)
+	{
+		auto& proxy = m_proxies[i];
+		if (proxy.object == nullptr)
+		{
+			continue;
+		}
+
+		store.GetBounds(proxy.object->GetEntity(), proxy.min, proxy.max);
+
+		if (proxy.node != NULL_NODE && BoxContains(m_nodes[proxy.node].min, m_nodes[proxy.node].max, proxy.min, proxy.max))
+		{
+			continue;
+		}
+
+		if (proxy.node == NULL_NODE)
+		{
+			proxy.node = AllocateNode();
+			m_nodes[proxy.node].proxy = i;
+		}
+		else
+		{
+			RemoveLeaf(proxy.node);
+		}
+
+		m_nodes[proxy.node].min = proxy.min - glm::vec2(FAT_MARGIN, FAT_MARGIN);
+		m_nodes[proxy.node].max = proxy.max + glm::vec2(FAT_MARGIN, FAT_MARGIN);
+		InsertLeaf(proxy.node);
+		m_moved.push_back(i);
+	}
+
+	// only moved proxies can have gained a pair, everything else is already in the contact list
+	for (const auto moved : m_moved)
+	{
+		const auto& node = m_nodes[m_proxies[moved].node];
+		QueryTree(node.min, node.max, [this, moved](const int other)
+		{
+			if (other != moved)
+			{
+				m_contacts.try_emplace(PairKey(moved, other), Contact{ std::min(moved, other), std::max(moved, other), false });
+			}
+			return true;
+		});
+	}
+
+	for (auto it = m_contacts.begin(); it != m_contacts.end();)
+	{
+		auto& contact = it->second;
+		const auto& proxy_a = m_proxies[contact.proxyA];
+		const auto& proxy_b = m_proxies[contact.proxyB];
+
+		// one side was removed, its object may already be gone so no END event
+		if (proxy_a.object == nullptr || proxy_b.object == nullptr)
+		{
+			it = m_contacts.erase(it);
+			continue;
+		}
+
+		const bool touching = proxy_a.object->IsEnabled() && proxy_b.object->IsEnabled() &&
+			Overlaps(proxy_a.min, proxy_a.max, proxy_b.min, proxy_b.max);
+
+		if (touching)
+		{
+			m_events.push_back({ proxy_a.object, proxy_b.object, contact.touching ? ContactEventType::STAY : ContactEventType::BEGIN });
+		}
+		else if (contact.touching)
+		{
+			m_events.push_back({ proxy_a.object, proxy_b.object, ContactEventType::END });
+		}
+		contact.touching = touching;
+
+		const auto& node_a = m_nodes[proxy_a.node];
+		const auto& node_b = m_nodes[proxy_b.node];
+		if (!Overlaps(node_a.min, node_a.max, node_b.min, node_b.max))
+		{
+			it = m_contacts.erase(it);
+			continue;
+		}
+		++it;
+	}
+
+	m_freeProxies.insert(m_freeProxies.end(), m_deadProxies.begin(), m_deadProxies.end());
+	m_deadProxies.clear();
+}
+
+const std::vector<ContactEvent>& CollisionWorld::GetContactEvents() const
+{
+	return m_events;
+}
+
+void CollisionWorld::Query(const glm::vec2 box_min, const glm::vec2 box_max, std::vector<GameObject*>& results) const
+{
+	QueryTree(box_min, box_max, [this, &results](const int proxy)
+	{
+		results.push_back(m_proxies[proxy].object);
+		return true;
+	});
+}
+
+int CollisionWorld::GetProxyCount() const
+{
+	return static_cast<int>(m_proxyByObject.size());
+}
+
+int CollisionWorld::GetContactCount() const
+{
+	return static_cast<int>(m_contacts.size());
+}
+
+int CollisionWorld::GetTreeHeight() const
+{
+	return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+}
+
+int CollisionWorld::AllocateNode()
+{
+	if (m_freeNode == NULL_NODE)
+	{
+		m_nodes.push_back({});
+		m_nodes.back().parent = NULL_NODE;
+		m_freeNode = static_cast<int>(m_nodes.size() - 1);
+	}
+
+	// free nodes are chained through their parent index
+	const int node = m_freeNode;
+	m_freeNode = m_nodes[node].parent;
+	m_nodes[node].parent = NULL_NODE;
+	m_nodes[node].child1 = NULL_NODE;
+	m_nodes[node].child2 = NULL_NODE;
+	m_nodes[node].height = 0;
+	m_nodes[node].proxy = -1;
+	return node;
+}
+
+void CollisionWorld::FreeNode(const int node)
+{
+	m_nodes[node].parent = m_freeNode;
+	m_nodes[node].height = -1;
+	m_freeNode = node;
+}
+
+void CollisionWorld::InsertLeaf(const int leaf)
+{
+	if (m_root == NULL_NODE)
+	{
+		m_root = leaf;
+		m_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// walk down to the sibling that makes the tree grow the least
+	const glm::vec2 leaf_min = m_nodes[leaf].min;
+	const glm::vec2 leaf_max = m_nodes[leaf].max;
+	int index = m_root;
+	while (!m_nodes[index].IsLeaf())
+	{
+		const auto& node = m_nodes[index];
+		const float area = Perimeter(node.min, node.max);
+		const float combined_area = Perimeter(glm::min(node.min, leaf_min), glm::max(node.max, leaf_max));
+
+		// cost of a new parent for this node and the leaf, and the cost pushed down to the children
+		const float cost = 2.0f * combined_area;
+		const float inheritance_cost = 2.0f * (combined_area - area);
+
+		auto child_cost = [&](const int child)
+		{
+			const auto& c = m_nodes[child];
+			const float enlarged = Perimeter(glm::min(c.min, leaf_min), glm::max(c.max, leaf_max));
+			return (c.IsLeaf() ? enlarged : enlarged - Perimeter(c.min, c.max)) + inheritance_cost;
+		};
+		const float cost1 = child_cost(node.child1);
+		const float cost2 = child_cost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int sibling = index;
+	const int old_parent = m_nodes[sibling].parent;
+	const int new_parent = AllocateNode();
+	m_nodes[new_parent].parent = old_parent;
+	m_nodes[new_parent].min = glm::min(m_nodes[sibling].min, leaf_min);
+	m_nodes[new_parent].max = glm::max(m_nodes[sibling].max, leaf_max);
+	m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+	m_nodes[new_parent].child1 = sibling;
+	m_nodes[new_parent].child2 = leaf;
+	m_nodes[sibling].parent = new_parent;
+	m_nodes[leaf].parent = new_parent;
+
+	if (old_parent != NULL_NODE)
+	{
+		if (m_nodes[old_parent].child1 == sibling)
+		{
+			m_nodes[old_parent].child1 = new_parent;
+		}
+		else
+		{
+			m_nodes[old_parent].child2 = new_parent;
+		}
+	}
+	else
+	{
+		m_root = new_parent;
+	}
+
+	Refit(m_nodes[leaf].parent);
+}
+
+void CollisionWorld::RemoveLeaf(const int leaf)
+{
+	if (leaf == m_root)
+	{
+		m_root = NULL_NODE;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].parent;
+	const int grand_parent = m_nodes[parent].parent;
+	const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// the sibling takes the parent's place
+	if (grand_parent != NULL_NODE)
+	{
+		if (m_nodes[grand_parent].child1 == parent)
+		{
+			m_nodes[grand_parent].child1 = sibling;
+		}
+		else
+		{
+			m_nodes[grand_parent].child2 = sibling;
+		}
+		m_nodes[sibling].parent = grand_parent;
+		FreeNode(parent);
+		Refit(grand_parent);
+	}
+	else
+	{
+		m_root = sibling;
+		m_nodes[sibling].parent = NULL_NODE;
+		FreeNode(parent);
+	}
+	m_nodes[leaf].parent = NULL_NODE;
+}
+
+void CollisionWorld::Refit(int node)
+{
+	// rebalance and recompute boxes on the way back up to the root
+	while (node != NULL_NODE)
+	{
+		node = Balance(node);
+
+		auto& current = m_nodes[node];
+		const auto& child1 = m_nodes[current.child1];
+		const auto& child2 = m_nodes[current.child2];
+		current.height = 1 + std::max(child1.height, child2.height);
+		current.min = glm::min(child1.min, child2.min);
+		current.max = glm::max(child1.max, child2.max);
+
+		node = current.parent;
+	}
+}
+
+int CollisionWorld::Balance(const int a)
+{
+	// rotates the taller child of a up a level when the children differ in height by more than one,
+	// returns the node that now sits where a was
+	auto& node_a = m_nodes[a];
+	if (node_a.IsLeaf() || node_a.height < 2)
+	{
+		return a;
+	}
+
+	const int b = node_a.child1;
+	const int c = node_a.child2;
+	const int balance = m_nodes[c].height - m_nodes[b].height;
+	if (balance >= -1 && balance <= 1)
+	{
+		return a;
+	}
+
+	// the taller child becomes the parent of a, a keeps the taller of that child's children
+	const int up = balance > 1 ? c : b;
+	const int stay = balance > 1 ? b : c;
+	auto& node_up = m_nodes[up];
+	const int f = node_up.child1;
+	const int g = node_up.child2;
+
+	node_up.child1 = a;
+	node_up.parent = node_a.parent;
+	node_a.parent = up;
+
+	if (node_up.parent != NULL_NODE)
+	{
+		if (m_nodes[node_up.parent].child1 == a)
+		{
+			m_nodes[node_up.parent].child1 = up;
+		}
+		else
+		{
+			m_nodes[node_up.parent].child2 = up;
+		}
+	}
+	else
+	{
+		m_root = up;
+	}
+
+	const bool keep_f = m_nodes[f].height > m_nodes[g].height;
+	const int kept = keep_f ? f : g;
+	const int moved = keep_f ? g : f;
+
+	node_up.child2 = kept;
+	if (balance > 1)
+	{
+		node_a.child2 = moved;
+	}
+	else
+	{
+		node_a.child1 = moved;
+	}
+	m_nodes[moved].parent = a;
+
+	node_a.min = glm::min(m_nodes[stay].min, m_nodes[moved].min);
+	node_a.max = glm::max(m_nodes[stay].max, m_nodes[moved].max);
+	node_a.height = 1 + std::max(m_nodes[stay].height, m_nodes[moved].height);
+
+	node_up.min = glm::min(node_a.min, m_nodes[kept].min);
+	node_up.max = glm::max(node_a.max, m_nodes[kept].max);
+	node_up.height = 1 + std::max(node_a.height, m_nodes[kept].height);
+
+	return up;
+}
+
+template <typename Callback>
+void CollisionWorld::QueryTree(const glm::vec2 box_min, const glm::vec2 box_max, Callback callback) const
+{
+	if (m_root == NULL_NODE)
+	{
+		return;
+	}
+
+	m_queryStack.clear();
+	m_queryStack.push_back(m_root);
+	while (!m_queryStack.empty())
+	{
+		const int index = m_queryStack.back();
+		m_queryStack.pop_back();
+
+		const auto& node = m_nodes[index];
+		if (!Overlaps(node.min, node.max, box_min, box_max))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (!callback(node.proxy))
+			{
+				return;
+			}
+		}
+		else
+		{
+			m_queryStack.push_back(node.child1);
+			m_queryStack.push_back(node.child2);
+		}
+	}
+}
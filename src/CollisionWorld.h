@@ -0,0 +1,114 @@
+#pragma once
+#ifndef __COLLISION_WORLD__
+#define __COLLISION_WORLD__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
+
+#include "GameObject.h"
+#include "ContactEventType.h"
+
+struct ContactEvent
+{
+	GameObject* first;
+	GameObject* second;
+	ContactEventType type;
+};
+
+/*
+ * Broadphase for every object registered with it. Each object gets a leaf in a dynamic AABB tree whose box
+ * is fattened by a margin, and the leaf is only re-inserted once the object leaves its fat box. Pairs whose
+ * fat boxes overlap become persistent contacts, and each Update reports when their real boxes begin, stay
+ * in or end contact.
+ */
+class CollisionWorld
+{
+public:
+	CollisionWorld();
+	~CollisionWorld();
+
+	// registered objects are picked up by the next Update
+	void Add(GameObject* object);
+	// forget the object straight away, its contacts are dropped without an END event
+	void Remove(GameObject* object);
+	void Clear();
+	[[nodiscard]] bool Contains(GameObject* object) const;
+
+	/*
+	 * Refits moved objects, finds new pairs and fills the contact events for this frame.
+	 * Reads the boxes written by ComponentStore::PrepareCollision, so run it after the ComponentStore update
+	 */
+	void Update();
+
+	[[nodiscard]] const std::vector<ContactEvent>& GetContactEvents() const;
+	// every registered object whose fat box overlaps the given box
+	void Query(glm::vec2 box_min, glm::vec2 box_max, std::vector<GameObject*>& results) const;
+
+	[[nodiscard]] int GetProxyCount() const;
+	[[nodiscard]] int GetContactCount() const;
+	[[nodiscard]] int GetTreeHeight() const;
+
+private:
+	static constexpr float FAT_MARGIN = 8.0f;
+	static constexpr int NULL_NODE = -1;
+
+	struct Node
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+		int parent;
+		int child1;
+		int child2;
+		int height; // leaves are 0, free nodes are -1
+		int proxy;
+
+		[[nodiscard]] bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	struct Proxy
+	{
+		GameObject* object;
+		int node;
+		glm::vec2 min;
+		glm::vec2 max;
+	};
+
+	struct Contact
+	{
+		int proxyA;
+		int proxyB;
+		bool touching;
+	};
+
+	// tree
+	int AllocateNode();
+	void FreeNode(int node);
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	int Balance(int node);
+	void Refit(int node);
+	template <typename Callback>
+	void QueryTree(glm::vec2 box_min, glm::vec2 box_max, Callback callback) const;
+
+	std::vector<Node> m_nodes;
+	int m_root;
+	int m_freeNode;
+	mutable std::vector<int> m_queryStack;
+
+	// proxies
+	std::vector<Proxy> m_proxies;
+	std::vector<int> m_freeProxies;
+	std::vector<int> m_deadProxies;
+	std::unordered_map<GameObject*, int> m_proxyByObject;
+	std::vector<int> m_moved;
+
+	// contacts, keyed by both proxy ids
+	std::unordered_map<uint64_t, Contact> m_contacts;
+	std::vector<ContactEvent> m_events;
+};
+
+#endif /* defined (__COLLISION_WORLD__) */
@@ -0,0 +1,228 @@
+#include "ComponentStore.h"
+
+#include <algorithm>
+#include <utility>
+
+
+ComponentStore::ComponentStore() : m_simulatedCount(0)
+{
+}
+
+ComponentStore::~ComponentStore()
+= default;
+
+uint32_t ComponentStore::CreateEntity(GameObject* owner)
+{
+	uint32_t entity;
+	if (!m_freeEntities.empty())
+	{
+		entity = m_freeEntities.back();
+		m_freeEntities.pop_back();
+	}
+	else
+	{
+		entity = static_cast<uint32_t>(m_entityToSlot.size());
+		m_entityToSlot.push_back(INVALID_ENTITY);
+	}
+
+	// new entities are not simulated, so they go at the back
+	const auto slot = static_cast<uint32_t>(m_transforms.size());
+	m_transforms.push_back(Transform{});
+	m_rigidBodies.push_back(RigidBody{});
+	m_sizes.emplace_back(0.0f, 0.0f);
+	m_centered.push_back(0);
+	m_owners.push_back(owner);
+	m_slotToEntity.push_back(entity);
+	m_boundsMin.emplace_back(0.0f, 0.0f);
+	m_boundsMax.emplace_back(0.0f, 0.0f);
+
+	m_entityToSlot[entity] = slot;
+	return entity;
+}
+
+void ComponentStore::DestroyEntity(const uint32_t entity)
+{
+	if (entity >= m_entityToSlot.size() || m_entityToSlot[entity] == INVALID_ENTITY)
+	{
+		return;
+	}
+
+	// leave the simulated range first so the swap with the last slot keeps both ranges packed
+	SetSimulated(entity, false);
+
+	const auto last_slot = static_cast<uint32_t>(m_transforms.size() - 1);
+	SwapSlots(m_entityToSlot[entity], last_slot);
+
+	m_transforms.pop_back();
+	m_rigidBodies.pop_back();
+	m_sizes.pop_back();
+	m_centered.pop_back();
+	m_owners.pop_back();
+	m_slotToEntity.pop_back();
+	m_boundsMin.pop_back();
+	m_boundsMax.pop_back();
+
+	m_entityToSlot[entity] = INVALID_ENTITY;
+	m_freeEntities.push_back(entity);
+}
+
+int ComponentStore::GetEntityCount() const
+{
+	return static_cast<int>(m_transforms.size());
+}
+
+int ComponentStore::GetSimulatedCount() const
+{
+	return static_cast<int>(m_simulatedCount);
+}
+
+Transform& ComponentStore::GetTransform(const uint32_t entity)
+{
+	return m_transforms[m_entityToSlot[entity]];
+}
+
+RigidBody& ComponentStore::GetRigidBody(const uint32_t entity)
+{
+	return m_rigidBodies[m_entityToSlot[entity]];
+}
+
+void ComponentStore::SetSize(const uint32_t entity, const int width, const int height)
+{
+	m_sizes[m_entityToSlot[entity]] = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+}
+
+void ComponentStore::SetCentered(const uint32_t entity, const bool state)
+{
+	m_centered[m_entityToSlot[entity]] = state ? 1 : 0;
+}
+
+void ComponentStore::SetSimulated(const uint32_t entity, const bool state)
+{
+	if (IsSimulated(entity) == state)
+	{
+		return;
+	}
+
+	if (state)
+	{
+		// grow the simulated range by swapping this entity into the first slot after it
+		SwapSlots(m_entityToSlot[entity], m_simulatedCount);
+		++m_simulatedCount;
+	}
+	else
+	{
+		// shrink the simulated range by swapping this entity into its last slot
+		--m_simulatedCount;
+		SwapSlots(m_entityToSlot[entity], m_simulatedCount);
+	}
+}
+
+bool ComponentStore::IsSimulated(const uint32_t entity) const
+{
+	return m_entityToSlot[entity] < m_simulatedCount;
+}
+
+void ComponentStore::Integrate(const float delta_time)
+{
+	for (uint32_t i = 0; i < m_simulatedCount; ++i)
+	{
+		m_rigidBodies[i].velocity += m_rigidBodies[i].acceleration * delta_time;
+	}
+
+	for (uint32_t i = 0; i < m_simulatedCount; ++i)
+	{
+		m_transforms[i].position += m_rigidBodies[i].velocity * delta_time;
+	}
+}
+
+void ComponentStore::ConstrainToBounds(const glm::vec2 world_min, const glm::vec2 world_max)
+{
+	for (uint32_t i = 0; i < m_simulatedCount; ++i)
+	{
+		// keep the whole box inside the world, centered objects are offset by half their size
+		const glm::vec2 offset = m_centered[i] ? m_sizes[i] * 0.5f : glm::vec2(0.0f, 0.0f);
+		const glm::vec2 low = world_min + offset;
+		const glm::vec2 high = world_max - m_sizes[i] + offset;
+
+		auto& position = m_transforms[i].position;
+		auto& velocity = m_rigidBodies[i].velocity;
+		if (position.x < low.x || position.x > high.x)
+		{
+			position.x = std::clamp(position.x, low.x, std::max(low.x, high.x));
+			velocity.x = 0.0f;
+		}
+		if (position.y < low.y || position.y > high.y)
+		{
+			position.y = std::clamp(position.y, low.y, std::max(low.y, high.y));
+			velocity.y = 0.0f;
+		}
+	}
+}
+
+void ComponentStore::PrepareCollision()
+{
+	// world space boxes for every entity, collision code reads these instead of recomputing them per pair
+	const auto count = m_transforms.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float half = m_centered[i] ? 0.5f : 0.0f;
+		m_boundsMin[i] = m_transforms[i].position - m_sizes[i] * half;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_boundsMax[i] = m_boundsMin[i] + m_sizes[i];
+	}
+}
+
+void ComponentStore::Update(const float delta_time, const std::optional<Bounds>& world_bounds)
+{
+	Integrate(delta_time);
+	if (world_bounds.has_value())
+	{
+		ConstrainToBounds(world_bounds->min, world_bounds->max);
+	}
+	PrepareCollision();
+}
+
+void ComponentStore::GetBounds(const uint32_t entity, glm::vec2& bounds_min, glm::vec2& bounds_max) const
+{
+	const auto slot = m_entityToSlot[entity];
+	bounds_min = m_boundsMin[slot];
+	bounds_max = m_boundsMax[slot];
+}
+
+const std::vector<glm::vec2>& ComponentStore::GetBoundsMin() const
+{
+	return m_boundsMin;
+}
+
+const std::vector<glm::vec2>& ComponentStore::GetBoundsMax() const
+{
+	return m_boundsMax;
+}
+
+const std::vector<GameObject*>& ComponentStore::GetOwners() const
+{
+	return m_owners;
+}
+
+void ComponentStore::SwapSlots(const uint32_t slot_a, const uint32_t slot_b)
+{
+	if (slot_a == slot_b)
+	{
+		return;
+	}
+
+	std::swap(m_transforms[slot_a], m_transforms[slot_b]);
+	std::swap(m_rigidBodies[slot_a], m_rigidBodies[slot_b]);
+	std::swap(m_sizes[slot_a], m_sizes[slot_b]);
+	std::swap(m_centered[slot_a], m_centered[slot_b]);
+	std::swap(m_owners[slot_a], m_owners[slot_b]);
+	std::swap(m_slotToEntity[slot_a], m_slotToEntity[slot_b]);
+	std::swap(m_boundsMin[slot_a], m_boundsMin[slot_b]);
+	std::swap(m_boundsMax[slot_a], m_boundsMax[slot_b]);
+
+	m_entityToSlot[m_slotToEntity[slot_a]] = slot_a;
+	m_entityToSlot[m_slotToEntity[slot_b]] = slot_b;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#ifndef __COMPONENT_STORE__
+#define __COMPONENT_STORE__
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Transform.h"
+#include "RigidBody.h"
+
+class GameObject;
+
+/* Singleton
+ * Owns the Transform and RigidBody of every GameObject in dense, contiguous arrays indexed by slot.
+ * A GameObject only keeps its entity id, which maps to a slot through a sparse table, so slots can be
+ * swapped to keep the arrays packed. Entities marked as simulated sit at the front of the arrays so the
+ * systems below run straight, branch-free loops over them.
+ */
+class ComponentStore
+{
+public:
+	// world rectangle simulated entities are kept inside, owned by the scene
+	struct Bounds
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+	};
+
+	static ComponentStore& Instance()
+	{
+		static ComponentStore instance;
+		return instance;
+	}
+
+	static constexpr uint32_t INVALID_ENTITY = UINT32_MAX;
+
+	// entity lifetime
+	uint32_t CreateEntity(GameObject* owner);
+	void DestroyEntity(uint32_t entity);
+	[[nodiscard]] int GetEntityCount() const;
+	[[nodiscard]] int GetSimulatedCount() const;
+
+	/*
+	 * Component access. References move when entities are created, destroyed or change simulated state,
+	 * so use them straight away rather than holding on to them
+	 */
+	Transform& GetTransform(uint32_t entity);
+	RigidBody& GetRigidBody(uint32_t entity);
+
+	void SetSize(uint32_t entity, int width, int height);
+	void SetCentered(uint32_t entity, bool state);
+
+	/*
+	 * Simulated entities are moved by Integrate and kept inside the world bounds by ConstrainToBounds,
+	 * everything else still moves itself in its own Update
+	 */
+	void SetSimulated(uint32_t entity, bool state);
+	[[nodiscard]] bool IsSimulated(uint32_t entity) const;
+
+	// systems
+	void Integrate(float delta_time);
+	void ConstrainToBounds(glm::vec2 world_min, glm::vec2 world_max);
+	void PrepareCollision();
+	// runs Integrate, ConstrainToBounds (skipped when world_bounds is empty) and PrepareCollision in that order
+	void Update(float delta_time, const std::optional<Bounds>& world_bounds);
+
+	// box written by the last PrepareCollision for one entity
+	void GetBounds(uint32_t entity, glm::vec2& bounds_min, glm::vec2& bounds_max) const;
+
+	// output of PrepareCollision, one entry per slot in the same order as GetOwners
+	[[nodiscard]] const std::vector<glm::vec2>& GetBoundsMin() const;
+	[[nodiscard]] const std::vector<glm::vec2>& GetBoundsMax() const;
+	[[nodiscard]] const std::vector<GameObject*>& GetOwners() const;
+
+private:
+	ComponentStore();
+	~ComponentStore();
+
+	void SwapSlots(uint32_t slot_a, uint32_t slot_b);
+
+	// dense, one entry per live entity
+	std::vector<Transform> m_transforms;
+	std::vector<RigidBody> m_rigidBodies;
+	std::vector<glm::vec2> m_sizes;
+	std::vector<uint8_t> m_centered;
+	std::vector<GameObject*> m_owners;
+	std::vector<uint32_t> m_slotToEntity;
+	std::vector<glm::vec2> m_boundsMin;
+	std::vector<glm::vec2> m_boundsMax;
+	uint32_t m_simulatedCount;
+
+	// sparse, indexed by entity id
+	std::vector<uint32_t> m_entityToSlot;
+	std::vector<uint32_t> m_freeEntities;
+};
+
+#endif /* defined (__COMPONENT_STORE__) */
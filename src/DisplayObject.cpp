@@ -27,6 +27,54 @@ uint32_t DisplayObject::GetLayerOrderIndex() const
 
 void DisplayObject::SetLayerIndex(const uint32_t new_index, const uint32_t new_order)
 {
+	if (m_layerIndex == new_index && m_layerOrderIndex == new_order)
+	{
+		return;
+	}
+
 	m_layerIndex = new_index;
 	m_layerOrderIndex = new_order;
+
+	if (m_pParentScene != nullptr)
+	{
+		m_pParentScene->m_displayListDirty = true;
+	}
+}
+
+void DisplayObject::SetEnabled(const bool state)
+{
+	if (IsEnabled() == state)
+	{
+		return;
+	}
+
+	GameObject::SetEnabled(state);
+
+	if (m_pParentScene != nullptr)
+	{
+		m_pParentScene->m_displayListDirty = true;
+	}
+}
+
+void DisplayObject::SetType(const GameObjectType new_type)
+{
+	if (GetType() == new_type)
+	{
+		return;
+	}
+
+	if (m_pParentScene == nullptr || m_pendingRemoval)
+	{
+		GameObject::SetType(new_type);
+		return;
+	}
+
+	m_pParentScene->RemoveFromTypeList(this);
+	GameObject::SetType(new_type);
+	m_pParentScene->AddToTypeList(this);
+}
+
+bool DisplayObject::IsPendingRemoval() const
+{
+	return m_pendingRemoval;
 }
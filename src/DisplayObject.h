@@ -34,13 +34,23 @@ public:
 	 * @param new_order The order within the layer, default is zero
 	 */
 	void SetLayerIndex(uint32_t new_index, const uint32_t new_order = 0);
-	
+
+	// Enabling or disabling moves the object within its scene's display list, so the scene is told to re-sort
+	void SetEnabled(bool state) override;
+	// Changing the type moves the object to the new type's list in its scene
+	void SetType(GameObjectType new_type) override;
+
+	// True once the parent scene has queued this object for removal, it is deleted at the end of the frame
+	[[nodiscard]] bool IsPendingRemoval() const;
+
 
 private:
 	friend class Scene;
 	uint32_t m_layerIndex = 0;
-	uint32_t m_layerOrderIndex;
+	uint32_t m_layerOrderIndex = 0;
 	Scene* m_pParentScene{};
+	int m_typeListIndex = -1;
+	bool m_pendingRemoval = false;
 };
 
 #endif /* defined (__DISPLAY_OBJECT__) */
@@ -46,6 +46,14 @@ void EndScene::HandleEvents()
 	}
 }
 
+AssetManifest EndScene::GetManifest()
+{
+	AssetManifest manifest;
+	manifest.AddFont(Label::FontPath("Dock51"), Label::FontID("Dock51", 80), 80);
+	manifest.AddTexture("../Assets/textures/restartButton.png", "restartButton");
+	return manifest;
+}
+
 void EndScene::Start()
 {
 	const SDL_Color blue = { 0, 0, 255, 255 };
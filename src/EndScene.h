@@ -3,6 +3,7 @@
 #define __END_SCENE__
 
 #include "Scene.h"
+#include "AssetManifest.h"
 #include "Label.h"
 #include "Button.h"
 
@@ -19,6 +20,9 @@ public:
 	virtual void HandleEvents() override;
 	virtual void Start() override;
 
+	// everything Start loads, so the scene can be loaded in the background before it is created
+	static AssetManifest GetManifest();
+
 private:
 	Label* m_label{};
 
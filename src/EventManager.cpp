@@ -1,13 +1,21 @@
 #include "EventManager.h"
 #include <iostream>
 #include "Game.h"
+#include "TextureManager.h"
 #include "WindowName.h"
 
 void EventManager::Reset()
 {
-    m_isActive = false;
-    SDL_Delay(300);
-    m_isActive = true;
+    // whatever is held now belongs to the scene that asked for the change, ignore it until it is released
+    m_keysCurr = SDL_GetKeyboardState(&m_numKeys);
+    m_heldSinceReset.assign(m_keysCurr, m_keysCurr + m_numKeys);
+    std::memcpy(m_keysLast, m_keysCurr, m_numKeys);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        m_mouseHeldSinceReset[i] = m_mouseButtons[i];
+    }
+    m_mouseLast = m_mouseCurrent;
 }
 
 void EventManager::Update()
@@ -97,6 +105,10 @@ void EventManager::Update()
                 OnKeyUp();
                 {
                     int key = event.key.keysym.scancode;
+                    if (key < static_cast<int>(m_heldSinceReset.size()))
+                    {
+                        m_heldSinceReset[key] = 0;
+                    }
                     IM_ASSERT(key >= 0 && key < IM_ARRAYSIZE(m_io.KeysDown));
                     m_io.KeysDown[key] = (event.type == SDL_KEYDOWN);
                     m_io.KeyShift = ((SDL_GetModState() & KMOD_SHIFT) != 0);
@@ -115,6 +127,10 @@ void EventManager::Update()
                 std::cout << "Controller Removed " << std::endl;
                 InitializeControllers();
                 break;
+            case SDL_RENDER_TARGETS_RESET:
+                // the texture pages are render targets and have been wiped, the static textures they were packed from survive
+                TextureManager::Instance().PackTextures();
+                break;
             case SDL_WINDOWEVENT:
                 switch (event.window.event)
                 {
@@ -186,11 +202,16 @@ bool EventManager::IsKeyDown(const SDL_Scancode key) const
 {
     if (m_keyStates != nullptr)
     {
-        if (m_keyStates[key] == 1) return true;
+        if (m_keyStates[key] == 1 && !IsHeldSinceReset(key)) return true;
     }
     return false;
 }
 
+bool EventManager::IsHeldSinceReset(const SDL_Scancode key) const
+{
+    return key < static_cast<int>(m_heldSinceReset.size()) && m_heldSinceReset[key] != 0;
+}
+
 bool EventManager::IsKeyUp(const SDL_Scancode key) const
 {
     if (m_keyStates != nullptr)
@@ -212,7 +233,7 @@ void EventManager::OnKeyUp()
 
 bool EventManager::KeyPressed(const SDL_Scancode c) const
 {
-    return (m_keysCurr[c] > m_keysLast[c]);
+    return (m_keysCurr[c] > m_keysLast[c]) && !IsHeldSinceReset(c);
 }
 
 bool EventManager::KeyReleased(const SDL_Scancode c) const
@@ -249,16 +270,19 @@ void EventManager::OnMouseButtonUp(const SDL_Event& event)
     if (event.button.button == SDL_BUTTON_LEFT)
     {
         m_mouseButtons[static_cast<int>(MouseButtons::LEFT)] = false;
+        m_mouseHeldSinceReset[static_cast<int>(MouseButtons::LEFT)] = false;
     }
 
     if (event.button.button == SDL_BUTTON_MIDDLE)
     {
         m_mouseButtons[static_cast<int>(MouseButtons::MIDDLE)] = false;
+        m_mouseHeldSinceReset[static_cast<int>(MouseButtons::MIDDLE)] = false;
     }
 
     if (event.button.button == SDL_BUTTON_RIGHT)
     {
         m_mouseButtons[static_cast<int>(MouseButtons::RIGHT)] = false;
+        m_mouseHeldSinceReset[static_cast<int>(MouseButtons::RIGHT)] = false;
     }
 }
 
@@ -317,7 +341,7 @@ void EventManager::IMGUIKeymap() const
 
 bool EventManager::GetMouseButton(const int button_number) const
 {
-    return m_mouseButtons[button_number];
+    return m_mouseButtons[button_number] && !m_mouseHeldSinceReset[button_number];
 }
 
 glm::vec2 EventManager::GetMousePosition() const
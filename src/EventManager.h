@@ -19,6 +19,10 @@ public:
 		return instance;
 	}
 
+	/*
+	 * Called when the scene changes. Keys and mouse buttons held at that moment read as up until they are
+	 * released, so the input that asked for the change can't also act on the next scene
+	 */
 	void Reset();
 
 	// update and clean the input handler
@@ -75,6 +79,8 @@ private:
 	// IMGUI IO
 	void IMGUIKeymap() const;
 
+	[[nodiscard]] bool IsHeldSinceReset(SDL_Scancode key) const;
+
 	/*------- PRIVATE MEMBER VARIABLES -------*/
 
 	// IMGUI variables
@@ -88,9 +94,12 @@ private:
 	const Uint8* m_keysCurr;
 	Uint8* m_keysLast;
 	int m_numKeys{};
+	// keys held down when Reset was called, cleared as each is released
+	std::vector<Uint8> m_heldSinceReset;
 
 	// mouse specific
 	bool m_mouseButtons[3]{};
+	bool m_mouseHeldSinceReset[3]{};
 	glm::vec2 m_mousePosition;
 	int m_mouseWheel;
 
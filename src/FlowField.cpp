@@ -0,0 +1,273 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+	bool CostLess(const float a, const float b)
+	{
+		// ignore float noise so repairs don't flip between equally cheap neighbours
+		return a < b - 0.0001f;
+	}
+}
+
+FlowField::FlowField() : m_cols(0), m_rows(0), m_target(0, 0), m_stamp(0), m_lastUpdatedCount(0)
+{
+}
+
+FlowField::~FlowField()
+= default;
+
+void FlowField::Build(const NavigationGrid& grid, const glm::ivec2 target)
+{
+	m_cols = grid.GetCols();
+	m_rows = grid.GetRows();
+	m_target = target;
+
+	const int tile_count = grid.GetTileCount();
+	m_cost.assign(tile_count, UNREACHABLE);
+	m_parent.assign(tile_count, -1);
+	m_direction.assign(tile_count, glm::vec2(0.0f, 0.0f));
+	m_invalidatedStamp.assign(tile_count, 0);
+	m_stamp = 0;
+	m_open.clear();
+	m_lastUpdatedCount = 0;
+
+	if (grid.IsBlocked(target.x, target.y))
+	{
+		return;
+	}
+
+	const int target_tile = grid.GetIndex(target.x, target.y);
+	m_cost[target_tile] = 0.0f;
+	PushOpen(0.0f, target_tile);
+	Propagate(grid);
+}
+
+void FlowField::TileChanged(const NavigationGrid& grid, const int col, const int row)
+{
+	m_lastUpdatedCount = 0;
+	if (!grid.InBounds(col, row))
+	{
+		return;
+	}
+
+	if (grid.GetCols() != m_cols || grid.GetRows() != m_rows || (col == m_target.x && row == m_target.y))
+	{
+		Build(grid, m_target);
+		return;
+	}
+
+	const int changed_tile = grid.GetIndex(col, row);
+	m_open.clear();
+
+	if (grid.IsBlocked(col, row))
+	{
+		// every tile whose route ran through the blocked tile, or cut diagonally past its corner, loses its cost
+		if (++m_stamp == 0)
+		{
+			std::fill(m_invalidatedStamp.begin(), m_invalidatedStamp.end(), 0);
+			m_stamp = 1;
+		}
+		m_invalidated.clear();
+		m_stack.clear();
+
+		m_stack.push_back(changed_tile);
+		m_invalidatedStamp[changed_tile] = m_stamp;
+		for (int i = 4; i < 8; ++i)
+		{
+			// the two tiles a diagonal step past this corner runs between
+			const int from_col = col + NavigationGrid::NEIGHBOUR_COLS[i];
+			const int from_row = row;
+			const int to_col = col;
+			const int to_row = row + NavigationGrid::NEIGHBOUR_ROWS[i];
+			if (!grid.InBounds(from_col, from_row) || !grid.InBounds(to_col, to_row))
+			{
+				continue;
+			}
+
+			const int from = grid.GetIndex(from_col, from_row);
+			const int to = grid.GetIndex(to_col, to_row);
+			if (m_parent[from] == to && m_invalidatedStamp[from] != m_stamp)
+			{
+				m_invalidatedStamp[from] = m_stamp;
+				m_stack.push_back(from);
+			}
+			if (m_parent[to] == from && m_invalidatedStamp[to] != m_stamp)
+			{
+				m_invalidatedStamp[to] = m_stamp;
+				m_stack.push_back(to);
+			}
+		}
+
+		// walk down the tree of parents to collect the whole region
+		while (!m_stack.empty())
+		{
+			const int tile = m_stack.back();
+			m_stack.pop_back();
+			m_invalidated.push_back(tile);
+
+			const auto position = grid.GetTile(tile);
+			for (int i = 0; i < 8; ++i)
+			{
+				const int neighbour_col = position.x + NavigationGrid::NEIGHBOUR_COLS[i];
+				const int neighbour_row = position.y + NavigationGrid::NEIGHBOUR_ROWS[i];
+				if (!grid.InBounds(neighbour_col, neighbour_row))
+				{
+					continue;
+				}
+				const int neighbour = grid.GetIndex(neighbour_col, neighbour_row);
+				if (m_parent[neighbour] == tile && m_invalidatedStamp[neighbour] != m_stamp)
+				{
+					m_invalidatedStamp[neighbour] = m_stamp;
+					m_stack.push_back(neighbour);
+				}
+			}
+		}
+
+		for (const auto tile : m_invalidated)
+		{
+			Invalidate(tile);
+		}
+
+		// the region's border still has valid costs, expanding it again refills the region
+		for (const auto tile : m_invalidated)
+		{
+			const auto position = grid.GetTile(tile);
+			for (int i = 0; i < 8; ++i)
+			{
+				const int neighbour_col = position.x + NavigationGrid::NEIGHBOUR_COLS[i];
+				const int neighbour_row = position.y + NavigationGrid::NEIGHBOUR_ROWS[i];
+				if (!grid.InBounds(neighbour_col, neighbour_row))
+				{
+					continue;
+				}
+				const int neighbour = grid.GetIndex(neighbour_col, neighbour_row);
+				if (m_invalidatedStamp[neighbour] != m_stamp && m_cost[neighbour] != UNREACHABLE)
+				{
+					PushOpen(m_cost[neighbour], neighbour);
+				}
+			}
+		}
+	}
+	else
+	{
+		// an opened tile can only make routes cheaper, so expanding its neighbours again lets them
+		// spread through it and through the diagonal steps it no longer blocks
+		for (int i = 0; i < 8; ++i)
+		{
+			const int neighbour_col = col + NavigationGrid::NEIGHBOUR_COLS[i];
+			const int neighbour_row = row + NavigationGrid::NEIGHBOUR_ROWS[i];
+			if (!grid.InBounds(neighbour_col, neighbour_row))
+			{
+				continue;
+			}
+			const int neighbour = grid.GetIndex(neighbour_col, neighbour_row);
+			if (m_cost[neighbour] != UNREACHABLE)
+			{
+				PushOpen(m_cost[neighbour], neighbour);
+			}
+		}
+	}
+
+	Propagate(grid);
+}
+
+glm::vec2 FlowField::GetDirection(const glm::vec2 world_position) const
+{
+	return GetDirection(static_cast<int>(std::floor(world_position.x / Config::TILE_SIZE)),
+		static_cast<int>(std::floor(world_position.y / Config::TILE_SIZE)));
+}
+
+glm::vec2 FlowField::GetDirection(const int col, const int row) const
+{
+	if (col < 0 || col >= m_cols || row < 0 || row >= m_rows)
+	{
+		return glm::vec2(0.0f, 0.0f);
+	}
+	return m_direction[row * m_cols + col];
+}
+
+float FlowField::GetCost(const int col, const int row) const
+{
+	if (col < 0 || col >= m_cols || row < 0 || row >= m_rows || m_cost[row * m_cols + col] == UNREACHABLE)
+	{
+		return -1.0f;
+	}
+	return m_cost[row * m_cols + col];
+}
+
+glm::ivec2 FlowField::GetTarget() const
+{
+	return m_target;
+}
+
+int FlowField::GetLastUpdatedCount() const
+{
+	return m_lastUpdatedCount;
+}
+
+void FlowField::SetParent(const int tile, const int parent)
+{
+	m_parent[tile] = parent;
+
+	const auto offset = glm::vec2(static_cast<float>(parent % m_cols - tile % m_cols), static_cast<float>(parent / m_cols - tile / m_cols));
+	const float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+	m_direction[tile] = offset / length;
+}
+
+void FlowField::Invalidate(const int tile)
+{
+	m_cost[tile] = UNREACHABLE;
+	m_parent[tile] = -1;
+	m_direction[tile] = glm::vec2(0.0f, 0.0f);
+}
+
+void FlowField::PushOpen(const float cost, const int tile)
+{
+	m_open.push_back({ cost, tile });
+	std::push_heap(m_open.begin(), m_open.end(), [](const OpenEntry& a, const OpenEntry& b) { return a.cost > b.cost; });
+}
+
+void FlowField::Propagate(const NavigationGrid& grid)
+{
+	const auto greater_cost = [](const OpenEntry& a, const OpenEntry& b) { return a.cost > b.cost; };
+
+	while (!m_open.empty())
+	{
+		std::pop_heap(m_open.begin(), m_open.end(), greater_cost);
+		const auto entry = m_open.back();
+		m_open.pop_back();
+
+		// stale entry, the tile has been reached more cheaply since
+		if (entry.cost > m_cost[entry.tile])
+		{
+			continue;
+		}
+
+		// the field flows towards the target, so relax the steps from each neighbour into this tile
+		const auto position = grid.GetTile(entry.tile);
+		for (int i = 0; i < 8; ++i)
+		{
+			const int neighbour_col = position.x + NavigationGrid::NEIGHBOUR_COLS[i];
+			const int neighbour_row = position.y + NavigationGrid::NEIGHBOUR_ROWS[i];
+			if (!grid.CanStep(position.x, position.y, NavigationGrid::NEIGHBOUR_COLS[i], NavigationGrid::NEIGHBOUR_ROWS[i]))
+			{
+				continue;
+			}
+
+			const int neighbour = grid.GetIndex(neighbour_col, neighbour_row);
+			const float cost = entry.cost + (i < 4 ? NavigationGrid::STRAIGHT_COST : NavigationGrid::DIAGONAL_COST);
+			if (CostLess(cost, m_cost[neighbour]))
+			{
+				m_cost[neighbour] = cost;
+				SetParent(neighbour, entry.tile);
+				PushOpen(cost, neighbour);
+				++m_lastUpdatedCount;
+			}
+		}
+	}
+}
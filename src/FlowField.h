@@ -0,0 +1,68 @@
+#pragma once
+#ifndef __FLOW_FIELD__
+#define __FLOW_FIELD__
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "NavigationGrid.h"
+
+/*
+ * Direction field towards one target tile, shared by every agent heading there. Build runs a single
+ * Dijkstra pass out from the target over the grid, after which each tile knows the cheapest neighbour to
+ * step to and GetDirection is a lookup. When tiles are blocked or opened, TileChanged repairs only the
+ * tiles whose route went through the change instead of rebuilding the whole field.
+ */
+class FlowField
+{
+public:
+	FlowField();
+	~FlowField();
+
+	void Build(const NavigationGrid& grid, glm::ivec2 target);
+
+	// call after changing one tile of the grid the field was built from
+	void TileChanged(const NavigationGrid& grid, int col, int row);
+
+	// unit vector towards the next tile on the way to the target, zero at the target or where it can't be reached
+	[[nodiscard]] glm::vec2 GetDirection(glm::vec2 world_position) const;
+	[[nodiscard]] glm::vec2 GetDirection(int col, int row) const;
+	// cost of the cheapest route to the target, negative where it can't be reached
+	[[nodiscard]] float GetCost(int col, int row) const;
+
+	[[nodiscard]] glm::ivec2 GetTarget() const;
+	// tiles whose cost was recomputed by the last Build or TileChanged
+	[[nodiscard]] int GetLastUpdatedCount() const;
+
+private:
+	struct OpenEntry
+	{
+		float cost;
+		int tile;
+	};
+
+	void SetParent(int tile, int parent);
+	void Invalidate(int tile);
+	void PushOpen(float cost, int tile);
+	void Propagate(const NavigationGrid& grid);
+
+	int m_cols;
+	int m_rows;
+	glm::ivec2 m_target;
+
+	std::vector<float> m_cost;
+	std::vector<int> m_parent;
+	std::vector<glm::vec2> m_direction;
+
+	// scratch, kept between updates so they don't allocate
+	std::vector<OpenEntry> m_open;
+	std::vector<int> m_stack;
+	std::vector<int> m_invalidated;
+	std::vector<uint32_t> m_invalidatedStamp;
+	uint32_t m_stamp;
+	int m_lastUpdatedCount;
+};
+
+#endif /* defined (__FLOW_FIELD__) */
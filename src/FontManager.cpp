@@ -4,12 +4,18 @@
 
 inline bool FontManager::CheckIfFontExists(const std::string& id)
 {
-	return m_fontMap.find(id) != m_fontMap.end();
+	return m_fonts.IsLoaded(m_fonts.Find(id));
+}
+
+FontHandle FontManager::GetFontHandle(const AssetName id)
+{
+	return m_fonts.Intern(id);
 }
 
 bool FontManager::Load(const std::string& file_name, const std::string& id, const int size, const int style)
 {
-	if (CheckIfFontExists(id))
+	const auto handle = m_fonts.Intern(id);
+	if (m_fonts.IsLoaded(handle))
 	{
 		return true;
 	}
@@ -18,18 +24,53 @@ bool FontManager::Load(const std::string& file_name, const std::string& id, cons
 	if (font != nullptr)
 	{
 		TTF_SetFontStyle(font.get(), style);
-		m_fontMap[id] = font;
+		m_fonts.Set(handle, font);
 		return true;
 	}
 
 	return false;
 }
 
+bool FontManager::LoadFromMemory(const FontHandle handle, std::shared_ptr<const std::vector<char>> data, const int size, const int style)
+{
+	if (m_fonts.IsLoaded(handle))
+	{
+		return true;
+	}
+
+	if (data == nullptr || data->empty())
+	{
+		return false;
+	}
+
+	// SDL_ttf reads from the data for as long as the font is open, so the deleter holds on to it
+	const auto font = TTF_OpenFontRW(SDL_RWFromConstMem(data->data(), static_cast<int>(data->size())), 1, size);
+	if (font == nullptr)
+	{
+		return false;
+	}
+
+	TTF_SetFontStyle(font, style);
+	m_fonts.Set(handle, std::shared_ptr<TTF_Font>(font, [data](TTF_Font* opened_font) { TTF_CloseFont(opened_font); }));
+	return true;
+}
+
 bool FontManager::TextToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, const SDL_Color colour)
 {
+	return TextToTexture(text, m_fonts.Find(font_id), TextureManager::Instance().GetTextureHandle(texture_id), colour);
+}
+
+bool FontManager::TextToTexture(const std::string& text, const FontHandle font, const TextureHandle texture, const SDL_Color colour)
+{
+	if (!m_fonts.IsLoaded(font))
+	{
+		printf("Unable to render text surface! Font not loaded\n");
+		return false;
+	}
+
 	//Render text surface
 
-	const auto textSurface(Config::MakeResource(TTF_RenderText_Solid(m_fontMap[font_id].get(), text.c_str(), colour)));
+	const auto textSurface(Config::MakeResource(TTF_RenderText_Solid(m_fonts.Get(font).get(), text.c_str(), colour)));
 
 	if (textSurface == nullptr)
 	{
@@ -41,8 +82,8 @@ bool FontManager::TextToTexture(const std::string& text, const std::string& font
 		const auto pTexture(Config::MakeResource(SDL_CreateTextureFromSurface(/* TheGame::Instance()->getRenderer()*/ Renderer::Instance().GetRenderer(), textSurface.get())));
 
 		//Create texture from surface pixels
-		TextureManager::Instance().AddTexture(texture_id, pTexture);
-		if (TextureManager::Instance().GetTexture(texture_id) == nullptr)
+		TextureManager::Instance().AddTexture(texture, pTexture);
+		if (TextureManager::Instance().GetTexture(texture) == nullptr)
 		{
 			printf("Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
 			return false;
@@ -54,25 +95,52 @@ bool FontManager::TextToTexture(const std::string& text, const std::string& font
 
 TTF_Font* FontManager::GetFont(const std::string& id)
 {
-	return m_fontMap[id].get();
+	return GetFont(m_fonts.Find(id));
+}
+
+TTF_Font* FontManager::GetFont(const FontHandle handle)
+{
+	return m_fonts.IsLoaded(handle) ? m_fonts.Get(handle).get() : nullptr;
 }
 
 void FontManager::Clean()
 {
-	m_fontMap.clear();
+	m_fonts.ResetAll();
+}
+
+void FontManager::AddReference(const FontHandle handle)
+{
+	m_fonts.AddReference(handle);
+}
+
+void FontManager::RemoveReference(const FontHandle handle)
+{
+	m_fonts.RemoveReference(handle);
+}
+
+void FontManager::CleanUnreferenced()
+{
+	for (uint32_t index = 0; index < m_fonts.GetSlotCount(); ++index)
+	{
+		if (m_fonts.IsLoaded(FontHandle{ index }) && m_fonts.GetReferenceCount(FontHandle{ index }) == 0)
+		{
+			m_fonts.Reset(FontHandle{ index });
+		}
+	}
 }
 
 void FontManager::DisplayFontMap()
 {
 	std::cout << "------------ Displaying Font Map -----------" << std::endl;
 
-	std::cout << "Font Map size: " << m_fontMap.size() << std::endl;
+	std::cout << "Font Map size: " << m_fonts.GetLoadedCount() << std::endl;
 
-	auto it = m_fontMap.begin();
-	while (it != m_fontMap.end())
+	for (uint32_t index = 0; index < m_fonts.GetSlotCount(); ++index)
 	{
-		std::cout << " " << it->first << std::endl;
-		++it;
+		if (m_fonts.IsLoaded(FontHandle{ index }))
+		{
+			std::cout << " " << m_fonts.GetName(FontHandle{ index }) << std::endl;
+		}
 	}
 }
 
@@ -6,12 +6,14 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // SDL Libraries
 #include<SDL.h>
 #include<SDL_image.h>
 #include <SDL_ttf.h>
 #include <string>
+#include "AssetRegistry.h"
 #include "Config.h"
 
 class FontManager
@@ -23,11 +25,27 @@ public:
 		return instance;
 	}
 
+	// stays valid across Load and Clean, look it up once and keep it
+	FontHandle GetFontHandle(AssetName id);
+
 	bool Load(const std::string& file_name, const std::string& id, int size, int style = TTF_STYLE_NORMAL);
+	/*
+	 * Opens a font from a file already read into memory, such as by the AssetLoader. The font keeps the data
+	 * alive for as long as it is open. Does nothing if the font is already loaded
+	 */
+	bool LoadFromMemory(FontHandle handle, std::shared_ptr<const std::vector<char>> data, int size, int style = TTF_STYLE_NORMAL);
 	bool TextToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, SDL_Color colour = { 0, 0, 0, 255 });
+	bool TextToTexture(const std::string& text, FontHandle font, TextureHandle texture, SDL_Color colour = { 0, 0, 0, 255 });
 	TTF_Font* GetFont(const std::string& id);
+	TTF_Font* GetFont(FontHandle handle);
 	void Clean();
 
+	// asset manifests hold a reference to every font they list so a scene change keeps shared ones open
+	void AddReference(FontHandle handle);
+	void RemoveReference(FontHandle handle);
+	// closes every font nothing holds a reference to
+	void CleanUnreferenced();
+
 	void DisplayFontMap();
 
 private:
@@ -36,7 +54,7 @@ private:
 
 	bool CheckIfFontExists(const std::string& id);
 
-	std::unordered_map<std::string, std::shared_ptr<TTF_Font>> m_fontMap;
+	AssetRegistry<FontTag, std::shared_ptr<TTF_Font>> m_fonts;
 
 	static FontManager* s_pInstance;
 };
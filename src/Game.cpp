@@ -5,12 +5,15 @@
 #include "glm/gtx/string_cast.hpp"
 #include "Renderer.h"
 #include "EventManager.h"
+#include "PathRequestManager.h"
+#include "AssetLoader.h"
+#include "AnimationManager.h"
 
 
 // Game functions - DO NOT REMOVE ***********************************************
 
 Game::Game() :
-	m_bRunning(true), m_frames(0), m_pCurrentScene(nullptr), m_currentSceneState(SceneState::NO_SCENE), m_pWindow(nullptr)
+	m_bRunning(true), m_frames(0), m_pCurrentScene(nullptr), m_currentSceneState(SceneState::NO_SCENE), m_pendingSceneState(SceneState::NO_SCENE), m_pWindow(nullptr)
 {
 	srand(static_cast<unsigned>(time(nullptr)));  // random seed
 }
@@ -133,49 +136,102 @@ void Game::SetDeltaTime(const float time)
 
 void Game::ChangeSceneState(const SceneState new_state)
 {
-	if (new_state != m_currentSceneState) {
+	if (new_state == m_pendingSceneState)
+	{
+		return;
+	}
 
-		// scene clean up
-		if (m_currentSceneState != SceneState::NO_SCENE)
+	if (new_state == m_currentSceneState)
+	{
+		if (m_pendingSceneState != SceneState::NO_SCENE)
 		{
-			m_pCurrentScene->Clean();
-			std::cout << "cleaning previous scene" << std::endl;
-			FontManager::Instance().Clean();
-			std::cout << "cleaning FontManager" << std::endl;
-			TextureManager::Instance().Clean();
-			std::cout << "cleaning TextureManager" << std::endl;
-			ImGuiWindowFrame::Instance().ClearWindow();
-			std::cout << "clearing ImGui Window" << std::endl;
+			AssetLoader::Instance().Cancel();
+			m_pendingSceneState = SceneState::NO_SCENE;
+			std::cout << "scene change cancelled" << std::endl;
 		}
+		return;
+	}
 
-		m_pCurrentScene = nullptr;
+	m_pendingSceneState = new_state;
+	m_pendingManifest = GetSceneManifest(new_state);
+	AssetLoader::Instance().Begin(m_pendingManifest);
+	std::cout << "loading next scene" << std::endl;
 
-		m_currentSceneState = new_state;
+	// the first scene has nothing to keep running while it loads
+	if (m_pCurrentScene == nullptr)
+	{
+		AssetLoader::Instance().Wait();
+		SwapScene();
+	}
+}
 
-		EventManager::Instance().Reset();
+void Game::SwapScene()
+{
+	// the next scene's assets are referenced before the old scene lets go, so the ones they share stay loaded
+	AssetLoader::Instance().Commit();
 
-		switch (m_currentSceneState)
-		{
-		case SceneState::START:
-			m_pCurrentScene = new StartScene();
-			std::cout << "start scene activated" << std::endl;
-			break;
-		case SceneState::PLAY:
-			m_pCurrentScene = new PlayScene();
-			std::cout << "play scene activated" << std::endl;
-			break;
-		case SceneState::END:
-			m_pCurrentScene = new EndScene();
-			std::cout << "end scene activated" << std::endl;
-			break;
-
-		default:
-			std::cout << "default case activated" << std::endl;
-			break;
-		
-		}
+	// scene clean up
+	if (m_pCurrentScene != nullptr)
+	{
+		m_pCurrentScene->Clean();
+		delete m_pCurrentScene;
+		std::cout << "cleaning previous scene" << std::endl;
+		AssetLoader::RemoveReferences(m_currentManifest);
+		FontManager::Instance().CleanUnreferenced();
+		std::cout << "cleaning FontManager" << std::endl;
+		TextureManager::Instance().CleanUnreferenced();
+		std::cout << "cleaning TextureManager" << std::endl;
+		ImGuiWindowFrame::Instance().ClearWindow();
+		std::cout << "clearing ImGui Window" << std::endl;
 	}
 
+	m_pCurrentScene = nullptr;
+
+	m_currentSceneState = m_pendingSceneState;
+	m_pendingSceneState = SceneState::NO_SCENE;
+	m_currentManifest = std::move(m_pendingManifest);
+	m_pendingManifest = AssetManifest{};
+
+	EventManager::Instance().Reset();
+
+	switch (m_currentSceneState)
+	{
+	case SceneState::START:
+		m_pCurrentScene = new StartScene();
+		std::cout << "start scene activated" << std::endl;
+		break;
+	case SceneState::PLAY:
+		m_pCurrentScene = new PlayScene();
+		std::cout << "play scene activated" << std::endl;
+		break;
+	case SceneState::END:
+		m_pCurrentScene = new EndScene();
+		std::cout << "end scene activated" << std::endl;
+		break;
+
+	default:
+		std::cout << "default case activated" << std::endl;
+		break;
+	
+	}
+
+	// everything the new scene loaded up front goes onto shared pages so its draws batch
+	TextureManager::Instance().PackTextures();
+}
+
+AssetManifest Game::GetSceneManifest(const SceneState state)
+{
+	switch (state)
+	{
+	case SceneState::START:
+		return StartScene::GetManifest();
+	case SceneState::PLAY:
+		return PlayScene::GetManifest();
+	case SceneState::END:
+		return EndScene::GetManifest();
+	default:
+		return {};
+	}
 }
 
 SDL_Window* Game::GetWindow() const
@@ -199,15 +255,40 @@ void Game::Render() const
 	ImGuiWindowFrame::Instance().Render();
 }
 
-void Game::Update() const
+void Game::Update()
 {
+	// the real time since the last Update, capped so a stall such as a breakpoint doesn't make everything jump
+	const auto now = SDL_GetPerformanceCounter();
+	if (m_lastUpdateCounter != 0)
+	{
+		const auto elapsed = static_cast<double>(now - m_lastUpdateCounter) / static_cast<double>(SDL_GetPerformanceFrequency());
+		SetDeltaTime(static_cast<float>(std::min(elapsed, 0.25)));
+	}
+	m_lastUpdateCounter = now;
+
+	TextureManager::Instance().UploadPendingTextures();
+
+	// swapping here rather than in ChangeSceneState means a scene is never deleted from inside its own callbacks
+	if (m_pendingSceneState != SceneState::NO_SCENE && AssetLoader::Instance().IsReady())
+	{
+		SwapScene();
+	}
+
 	m_pCurrentScene->Update();
+
+	// every animation is advanced here in one pass, by time rather than by frames drawn
+	const float delta_time = m_deltaTime > 0.0f ? m_deltaTime : 1.0f / 60.0f;
+	AnimationManager::Instance().Update(delta_time);
 }
 
 void Game::Clean() const
 {
 	std::cout << "cleaning game" << std::endl;
 
+	PathRequestManager::Instance().Shutdown();
+	AssetLoader::Instance().Shutdown();
+	TextureManager::Instance().Shutdown();
+
 	// Clean Up for IMGUI
 	//ImGui::DestroyContext();
 	ImGuiWindowFrame::Instance().Clean();
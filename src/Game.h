@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include "SceneState.h"
+#include "AssetManifest.h"
 
 #include <SDL.h>
 
@@ -37,7 +38,7 @@ public:
 
 	// public life cycle functions
 	void Render() const;
-	void Update() const;
+	void Update();
 	void HandleEvents() const;
 	void Clean() const;
 	void Start();
@@ -53,6 +54,11 @@ public:
 	void SetDeltaTime(float time);
 
 	[[nodiscard]] bool IsRunning() const;
+	/*
+	 * Starts loading the new scene's AssetManifest in the background and keeps the current scene running.
+	 * The scenes are swapped by the first Update after everything has loaded. Asking for the scene that is
+	 * already running drops a change that is still loading
+	 */
 	void ChangeSceneState(SceneState new_state);
 
 	[[nodiscard]] SDL_Window* GetWindow() const;
@@ -65,11 +71,20 @@ private:
 	bool m_bRunning;
 	Uint32 m_frames;
 	float m_deltaTime{};
+	// performance counter at the start of the last Update, 0 before the first one
+	Uint64 m_lastUpdateCounter{};
 	glm::vec2 m_mousePosition;
 
 	// scene variables
 	Scene* m_pCurrentScene;
 	SceneState m_currentSceneState;
+	// NO_SCENE unless a scene change is waiting on the AssetLoader
+	SceneState m_pendingSceneState;
+	AssetManifest m_currentManifest;
+	AssetManifest m_pendingManifest;
+
+	void SwapScene();
+	static AssetManifest GetSceneManifest(SceneState state);
 
 	// storage structures
 	std::shared_ptr<SDL_Window> m_pWindow;
@@ -1,21 +1,41 @@
 #include "GameObject.h"
 
+#include "ComponentStore.h"
+
 GameObject::GameObject() :
-	m_width(0), m_height(0), m_type(GameObjectType::NONE), m_enabled(true), m_visible(true)
+	m_entity(ComponentStore::Instance().CreateEntity(this)),
+	m_width(0), m_height(0), m_type(GameObjectType::NONE), m_enabled(true), m_visible(true), m_isCentered(false)
 {
 }
 
 GameObject::~GameObject()
-= default;
+{
+	ComponentStore::Instance().DestroyEntity(m_entity);
+}
 
 Transform* GameObject::GetTransform()
 {
-	return &m_transform;
+	return &ComponentStore::Instance().GetTransform(m_entity);
 }
 
 RigidBody* GameObject::GetRigidBody()
 {
-	return &m_rigidBody;
+	return &ComponentStore::Instance().GetRigidBody(m_entity);
+}
+
+void GameObject::SetSimulated(const bool state)
+{
+	ComponentStore::Instance().SetSimulated(m_entity, state);
+}
+
+bool GameObject::IsSimulated() const
+{
+	return ComponentStore::Instance().IsSimulated(m_entity);
+}
+
+uint32_t GameObject::GetEntity() const
+{
+	return m_entity;
 }
 
 int GameObject::GetWidth() const
@@ -36,11 +56,13 @@ GameObjectType GameObject::GetType() const
 void GameObject::SetWidth(const int new_width)
 {
 	m_width = new_width;
+	ComponentStore::Instance().SetSize(m_entity, m_width, m_height);
 }
 
 void GameObject::SetHeight(const int new_height)
 {
 	m_height = new_height;
+	ComponentStore::Instance().SetSize(m_entity, m_width, m_height);
 }
 
 void GameObject::SetType(const GameObjectType new_type)
@@ -71,6 +93,7 @@ bool GameObject::IsVisible() const
 void GameObject::setIsCentered(const bool state)
 {
 	m_isCentered = state;
+	ComponentStore::Instance().SetCentered(m_entity, state);
 }
 
 bool GameObject::isCentered() const
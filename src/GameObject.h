@@ -4,6 +4,7 @@
 
 #include "Transform.h"
 #include "RigidBody.h"
+#include <cstdint>
 #include <string>
 
 // enums
@@ -15,6 +16,10 @@ public:
 	GameObject();
 	virtual ~GameObject();
 
+	// each game object owns one entity in the ComponentStore, so it can't be copied
+	GameObject(const GameObject&) = delete;
+	GameObject& operator=(const GameObject&) = delete;
+
 	// Draw the object
 	virtual void Draw() = 0;
 
@@ -24,21 +29,26 @@ public:
 	// remove anything that needs to be deleted
 	virtual void Clean() = 0;
 
-	// getters for common variables
+	// getters for common variables, the components live in the ComponentStore
 	Transform* GetTransform();
 
 	// getters and setters for physics properties
 	RigidBody* GetRigidBody();
 
+	// when simulated, the ComponentStore integrates the rigid body every frame instead of the object's own Update
+	void SetSimulated(bool state);
+	[[nodiscard]] bool IsSimulated() const;
+	[[nodiscard]] uint32_t GetEntity() const;
+
 	// getters and setters for game object properties
 	[[nodiscard]] int GetWidth() const;
 	[[nodiscard]] int GetHeight() const;
 	void SetWidth(int new_width);
 	void SetHeight(int new_height);
 	[[nodiscard]] GameObjectType GetType() const;
-	void SetType(GameObjectType new_type);
+	virtual void SetType(GameObjectType new_type);
 
-	void SetEnabled(bool state);
+	virtual void SetEnabled(bool state);
 	[[nodiscard]] bool IsEnabled() const;
 
 	void SetVisible(bool state);
@@ -48,11 +58,8 @@ public:
 	[[nodiscard]] bool isCentered() const;
 
 private:
-	// transform component
-	Transform m_transform;
-
-	// rigid body component
-	RigidBody m_rigidBody;
+	// handle to the transform and rigid body components in the ComponentStore
+	uint32_t m_entity;
 
 	// size variables
 	int m_width;
@@ -0,0 +1,644 @@
+#include "HierarchicalPathFinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+#include "PathFinder.h"
+
+namespace
+{
+	constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+	// entrances shorter than this get one transition in the middle, longer ones get one at each end
+	constexpr int LONG_ENTRANCE = 6;
+}
+
+HierarchicalPathFinder::HierarchicalPathFinder() :
+	m_clusterSize(0), m_clusterCols(0), m_clusterRows(0), m_localGeneration(0), m_abstractGeneration(0)
+{
+}
+
+HierarchicalPathFinder::~HierarchicalPathFinder()
+= default;
+
+void HierarchicalPathFinder::Build(const NavigationGrid& grid, const int cluster_size)
+{
+	m_clusterSize = std::max(cluster_size, 2);
+	m_clusterCols = (grid.GetCols() + m_clusterSize - 1) / m_clusterSize;
+	m_clusterRows = (grid.GetRows() + m_clusterSize - 1) / m_clusterSize;
+
+	m_clusters.clear();
+	for (int cluster_row = 0; cluster_row < m_clusterRows; ++cluster_row)
+	{
+		for (int cluster_col = 0; cluster_col < m_clusterCols; ++cluster_col)
+		{
+			Cluster cluster;
+			cluster.firstCol = cluster_col * m_clusterSize;
+			cluster.firstRow = cluster_row * m_clusterSize;
+			cluster.lastCol = std::min(cluster.firstCol + m_clusterSize, grid.GetCols()) - 1;
+			cluster.lastRow = std::min(cluster.firstRow + m_clusterSize, grid.GetRows()) - 1;
+			m_clusters.push_back(cluster);
+		}
+	}
+
+	m_nodes.clear();
+	m_freeNodes.clear();
+	m_nodeAtTile.assign(grid.GetTileCount(), -1);
+	m_borders.assign((m_clusterCols - 1) * m_clusterRows + m_clusterCols * (m_clusterRows - 1), {});
+
+	m_localCost.assign(grid.GetTileCount(), UNREACHABLE);
+	m_localParent.assign(grid.GetTileCount(), -1);
+	m_localStamp.assign(grid.GetTileCount(), 0);
+	m_localClosedStamp.assign(grid.GetTileCount(), 0);
+	m_localGeneration = 0;
+
+	for (int cluster_row = 0; cluster_row < m_clusterRows; ++cluster_row)
+	{
+		for (int cluster_col = 0; cluster_col < m_clusterCols; ++cluster_col)
+		{
+			if (cluster_col + 1 < m_clusterCols)
+			{
+				BuildBorder(grid, cluster_col, cluster_row, true);
+			}
+			if (cluster_row + 1 < m_clusterRows)
+			{
+				BuildBorder(grid, cluster_col, cluster_row, false);
+			}
+		}
+	}
+
+	for (int cluster = 0; cluster < static_cast<int>(m_clusters.size()); ++cluster)
+	{
+		BuildClusterEdges(grid, cluster);
+	}
+}
+
+void HierarchicalPathFinder::TileChanged(const NavigationGrid& grid, const int col, const int row)
+{
+	if (!grid.InBounds(col, row))
+	{
+		return;
+	}
+	if (static_cast<int>(m_nodeAtTile.size()) != grid.GetTileCount())
+	{
+		Build(grid, m_clusterSize);
+		return;
+	}
+
+	const int cluster_col = col / m_clusterSize;
+	const int cluster_row = row / m_clusterSize;
+
+	// entrances only depend on border tiles, so a tile inside a cluster just changes its distances
+	int affected[3] = { GetClusterIndex(col, row), -1, -1 };
+	int affected_count = 1;
+	auto rebuild_border = [&](const int border_col, const int border_row, const bool vertical, const int other_cluster)
+	{
+		const int border = GetBorderIndex(border_col, border_row, vertical);
+		ClearBorder(border);
+		BuildBorder(grid, border_col, border_row, vertical);
+		affected[affected_count++] = other_cluster;
+	};
+
+	if (col % m_clusterSize == m_clusterSize - 1 && cluster_col + 1 < m_clusterCols)
+	{
+		rebuild_border(cluster_col, cluster_row, true, cluster_row * m_clusterCols + cluster_col + 1);
+	}
+	else if (col % m_clusterSize == 0 && cluster_col > 0)
+	{
+		rebuild_border(cluster_col - 1, cluster_row, true, cluster_row * m_clusterCols + cluster_col - 1);
+	}
+
+	if (row % m_clusterSize == m_clusterSize - 1 && cluster_row + 1 < m_clusterRows)
+	{
+		rebuild_border(cluster_col, cluster_row, false, (cluster_row + 1) * m_clusterCols + cluster_col);
+	}
+	else if (row % m_clusterSize == 0 && cluster_row > 0)
+	{
+		rebuild_border(cluster_col, cluster_row - 1, false, (cluster_row - 1) * m_clusterCols + cluster_col);
+	}
+
+	for (int i = 0; i < affected_count; ++i)
+	{
+		BuildClusterEdges(grid, affected[i]);
+	}
+}
+
+bool HierarchicalPathFinder::FindAbstractPath(const NavigationGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, const Heuristic heuristic, std::vector<glm::ivec2>& waypoints)
+{
+	waypoints.clear();
+	if (m_clusters.empty() || grid.IsBlocked(start.x, start.y) || grid.IsBlocked(goal.x, goal.y))
+	{
+		return false;
+	}
+	if (start == goal)
+	{
+		waypoints.push_back(start);
+		return true;
+	}
+
+	const int node_count = static_cast<int>(m_nodes.size());
+	const int temporary_start = node_count;
+	const int temporary_goal = node_count + 1;
+	if (static_cast<int>(m_abstractCost.size()) < node_count + 2)
+	{
+		m_abstractCost.resize(node_count + 2);
+		m_abstractParent.resize(node_count + 2);
+		m_abstractStamp.resize(node_count + 2, 0);
+		m_abstractClosedStamp.resize(node_count + 2, 0);
+	}
+	if (static_cast<int>(m_goalCostByNode.size()) < node_count)
+	{
+		m_goalCostByNode.resize(node_count, UNREACHABLE);
+	}
+
+	const int start_tile = grid.GetIndex(start.x, start.y);
+	const int goal_tile = grid.GetIndex(goal.x, goal.y);
+	const int start_cluster = GetClusterIndex(start.x, start.y);
+	const int goal_cluster = GetClusterIndex(goal.x, goal.y);
+
+	// link a start that isn't an abstract node to the nodes of its cluster, and to the goal if it shares the cluster
+	int start_id = m_nodeAtTile[start_tile];
+	m_startEdges.clear();
+	if (start_id < 0)
+	{
+		start_id = temporary_start;
+		SearchCluster(grid, start_cluster, start_tile, -1);
+		for (const auto node : m_clusters[start_cluster].nodes)
+		{
+			if (WasReached(m_nodes[node].tile))
+			{
+				m_startEdges.push_back({ node, m_localCost[m_nodes[node].tile], false });
+			}
+		}
+		if (start_cluster == goal_cluster && WasReached(goal_tile))
+		{
+			const int goal_node = m_nodeAtTile[goal_tile];
+			m_startEdges.push_back({ goal_node >= 0 ? goal_node : temporary_goal, m_localCost[goal_tile], false });
+		}
+	}
+
+	// likewise link a goal that isn't an abstract node, distances are symmetric so search out from the goal
+	int goal_id = m_nodeAtTile[goal_tile];
+	m_goalLinkedNodes.clear();
+	if (goal_id < 0)
+	{
+		goal_id = temporary_goal;
+		SearchCluster(grid, goal_cluster, goal_tile, -1);
+		for (const auto node : m_clusters[goal_cluster].nodes)
+		{
+			if (WasReached(m_nodes[node].tile))
+			{
+				m_goalCostByNode[node] = m_localCost[m_nodes[node].tile];
+				m_goalLinkedNodes.push_back(node);
+			}
+		}
+	}
+
+	if (++m_abstractGeneration == 0)
+	{
+		std::fill(m_abstractStamp.begin(), m_abstractStamp.end(), 0);
+		std::fill(m_abstractClosedStamp.begin(), m_abstractClosedStamp.end(), 0);
+		m_abstractGeneration = 1;
+	}
+
+	auto tile_of = [&](const int id)
+	{
+		if (id == temporary_start)
+		{
+			return start;
+		}
+		if (id == temporary_goal)
+		{
+			return goal;
+		}
+		return grid.GetTile(m_nodes[id].tile);
+	};
+	const auto greater_cost = [](const OpenEntry& a, const OpenEntry& b) { return a.estimatedCost > b.estimatedCost; };
+	auto relax = [&](const int from, const int to, const float step_cost)
+	{
+		const float cost = m_abstractCost[from] + step_cost;
+		if (m_abstractClosedStamp[to] == m_abstractGeneration ||
+			(m_abstractStamp[to] == m_abstractGeneration && cost >= m_abstractCost[to]))
+		{
+			return;
+		}
+		m_abstractStamp[to] = m_abstractGeneration;
+		m_abstractCost[to] = cost;
+		m_abstractParent[to] = from;
+		m_abstractOpen.push_back({ cost + NavigationGrid::EstimateCost(tile_of(to), goal, heuristic, true), to });
+		std::push_heap(m_abstractOpen.begin(), m_abstractOpen.end(), greater_cost);
+	};
+
+	m_abstractOpen.clear();
+	m_abstractStamp[start_id] = m_abstractGeneration;
+	m_abstractCost[start_id] = 0.0f;
+	m_abstractParent[start_id] = -1;
+	m_abstractOpen.push_back({ NavigationGrid::EstimateCost(start, goal, heuristic, true), start_id });
+
+	bool found = false;
+	while (!m_abstractOpen.empty())
+	{
+		std::pop_heap(m_abstractOpen.begin(), m_abstractOpen.end(), greater_cost);
+		const int current = m_abstractOpen.back().id;
+		m_abstractOpen.pop_back();
+		if (m_abstractClosedStamp[current] == m_abstractGeneration)
+		{
+			continue;
+		}
+		m_abstractClosedStamp[current] = m_abstractGeneration;
+
+		if (current == goal_id)
+		{
+			found = true;
+			break;
+		}
+
+		const auto& edges = current == temporary_start ? m_startEdges : m_nodes[current].edges;
+		for (const auto& edge : edges)
+		{
+			relax(current, edge.to, edge.cost);
+		}
+		if (goal_id == temporary_goal && current < node_count && m_goalCostByNode[current] != UNREACHABLE)
+		{
+			relax(current, temporary_goal, m_goalCostByNode[current]);
+		}
+	}
+
+	for (const auto node : m_goalLinkedNodes)
+	{
+		m_goalCostByNode[node] = UNREACHABLE;
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	for (int id = goal_id; id != -1; id = m_abstractParent[id])
+	{
+		waypoints.push_back(tile_of(id));
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	return true;
+}
+
+bool HierarchicalPathFinder::RefineSegment(const NavigationGrid& grid, const glm::ivec2 from, const glm::ivec2 to, std::vector<glm::ivec2>& path)
+{
+	if (from == to)
+	{
+		return true;
+	}
+
+	// border crossings and other single steps need no search
+	const int step_col = to.x - from.x;
+	const int step_row = to.y - from.y;
+	if (std::abs(step_col) <= 1 && std::abs(step_row) <= 1 && grid.CanStep(from.x, from.y, step_col, step_row))
+	{
+		path.push_back(to);
+		return true;
+	}
+
+	const int cluster = GetClusterIndex(from.x, from.y);
+	if (cluster != GetClusterIndex(to.x, to.y))
+	{
+		return false;
+	}
+
+	const int from_tile = grid.GetIndex(from.x, from.y);
+	const int to_tile = grid.GetIndex(to.x, to.y);
+	SearchCluster(grid, cluster, from_tile, to_tile);
+	if (!WasReached(to_tile))
+	{
+		return false;
+	}
+
+	const auto first = path.size();
+	for (int tile = to_tile; tile != from_tile; tile = m_localParent[tile])
+	{
+		path.push_back(grid.GetTile(tile));
+	}
+	std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+	return true;
+}
+
+bool HierarchicalPathFinder::FindPath(const NavigationGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, const Heuristic heuristic, std::vector<glm::ivec2>& path)
+{
+	path.clear();
+
+	if (!FindAbstractPath(grid, start, goal, heuristic, m_waypoints))
+	{
+		return false;
+	}
+
+	path.push_back(start);
+	for (size_t i = 1; i < m_waypoints.size(); ++i)
+	{
+		if (!RefineSegment(grid, m_waypoints[i - 1], m_waypoints[i], path))
+		{
+			path.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+int HierarchicalPathFinder::GetClusterSize() const
+{
+	return m_clusterSize;
+}
+
+int HierarchicalPathFinder::GetAbstractNodeCount() const
+{
+	return static_cast<int>(m_nodes.size() - m_freeNodes.size());
+}
+
+void HierarchicalPathFinder::RunBenchmark(const int cols, const int rows, const float blocked_ratio, const int query_count, const unsigned int seed)
+{
+	std::mt19937 random_generator(seed);
+	NavigationGrid grid(cols, rows);
+	const auto open_tiles = grid.BlockRandomly(blocked_ratio, random_generator);
+
+	if (open_tiles.size() < 2)
+	{
+		std::cout << "HPA* benchmark: map has no open tiles" << std::endl;
+		return;
+	}
+
+	std::uniform_int_distribution<size_t> pick(0, open_tiles.size() - 1);
+	std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+	for (int i = 0; i < query_count; ++i)
+	{
+		queries.emplace_back(grid.GetTile(open_tiles[pick(random_generator)]), grid.GetTile(open_tiles[pick(random_generator)]));
+	}
+
+	auto build_start = std::chrono::steady_clock::now();
+	HierarchicalPathFinder hierarchical_path_finder;
+	hierarchical_path_finder.Build(grid);
+	const auto build_milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+	std::cout << "HPA* benchmark: " << cols << "x" << rows << " tiles, " << blocked_ratio * 100.0f << "% blocked, "
+		<< query_count << " queries, " << hierarchical_path_finder.GetAbstractNodeCount() << " abstract nodes built in "
+		<< build_milliseconds << " ms" << std::endl;
+
+	PathFinder path_finder;
+	path_finder.SetAllowDiagonals(true);
+	std::vector<glm::ivec2> path;
+
+	auto time_queries = [&](const char* label, auto&& find)
+	{
+		int found = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (const auto& query : queries)
+		{
+			if (find(query.first, query.second))
+			{
+				++found;
+			}
+		}
+		const auto microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "  " << label << ": " << found << " found, " << microseconds / query_count << " us per query" << std::endl;
+	};
+
+	time_queries("A*", [&](const glm::ivec2 from, const glm::ivec2 to)
+	{
+		return path_finder.FindPath(grid, from, to, EUCLIDEAN, path);
+	});
+	time_queries("HPA* waypoints", [&](const glm::ivec2 from, const glm::ivec2 to)
+	{
+		return hierarchical_path_finder.FindAbstractPath(grid, from, to, EUCLIDEAN, path);
+	});
+	time_queries("HPA* full path", [&](const glm::ivec2 from, const glm::ivec2 to)
+	{
+		return hierarchical_path_finder.FindPath(grid, from, to, EUCLIDEAN, path);
+	});
+}
+
+int HierarchicalPathFinder::GetClusterIndex(const int col, const int row) const
+{
+	return (row / m_clusterSize) * m_clusterCols + col / m_clusterSize;
+}
+
+int HierarchicalPathFinder::GetOrCreateNode(const NavigationGrid& grid, const int tile)
+{
+	if (m_nodeAtTile[tile] >= 0)
+	{
+		return m_nodeAtTile[tile];
+	}
+
+	int node;
+	if (!m_freeNodes.empty())
+	{
+		node = m_freeNodes.back();
+		m_freeNodes.pop_back();
+	}
+	else
+	{
+		node = static_cast<int>(m_nodes.size());
+		m_nodes.emplace_back();
+	}
+
+	const auto position = grid.GetTile(tile);
+	m_nodes[node].tile = tile;
+	m_nodes[node].cluster = GetClusterIndex(position.x, position.y);
+	m_nodes[node].alive = true;
+	m_nodes[node].edges.clear();
+	m_clusters[m_nodes[node].cluster].nodes.push_back(node);
+	m_nodeAtTile[tile] = node;
+	return node;
+}
+
+void HierarchicalPathFinder::RemoveNode(const int node)
+{
+	auto& cluster_nodes = m_clusters[m_nodes[node].cluster].nodes;
+	const auto it = std::find(cluster_nodes.begin(), cluster_nodes.end(), node);
+	if (it != cluster_nodes.end())
+	{
+		*it = cluster_nodes.back();
+		cluster_nodes.pop_back();
+	}
+
+	m_nodeAtTile[m_nodes[node].tile] = -1;
+	m_nodes[node].alive = false;
+	m_nodes[node].edges.clear();
+	m_freeNodes.push_back(node);
+}
+
+int HierarchicalPathFinder::GetBorderIndex(const int cluster_col, const int cluster_row, const bool vertical) const
+{
+	if (vertical)
+	{
+		return cluster_row * (m_clusterCols - 1) + cluster_col;
+	}
+	return (m_clusterCols - 1) * m_clusterRows + cluster_row * m_clusterCols + cluster_col;
+}
+
+void HierarchicalPathFinder::ClearBorder(const int border)
+{
+	for (const auto& [first, second] : m_borders[border])
+	{
+		for (const auto& [node, other] : { std::make_pair(first, second), std::make_pair(second, first) })
+		{
+			if (!m_nodes[node].alive)
+			{
+				continue;
+			}
+
+			auto& edges = m_nodes[node].edges;
+			edges.erase(std::remove_if(edges.begin(), edges.end(), [other = other](const Edge& edge)
+			{
+				return edge.crossesBorder && edge.to == other;
+			}), edges.end());
+
+			// a node that no longer sits on any entrance goes away
+			if (std::none_of(edges.begin(), edges.end(), [](const Edge& edge) { return edge.crossesBorder; }))
+			{
+				RemoveNode(node);
+			}
+		}
+	}
+	m_borders[border].clear();
+}
+
+void HierarchicalPathFinder::BuildBorder(const NavigationGrid& grid, const int cluster_col, const int cluster_row, const bool vertical)
+{
+	const auto& cluster = m_clusters[cluster_row * m_clusterCols + cluster_col];
+	const int border = GetBorderIndex(cluster_col, cluster_row, vertical);
+
+	// walk along the border, the first side is this cluster's last column or row and the second is just past it
+	const int length = vertical ? cluster.lastRow - cluster.firstRow + 1 : cluster.lastCol - cluster.firstCol + 1;
+	auto side_tiles = [&](const int offset)
+	{
+		return vertical ?
+			std::make_pair(glm::ivec2(cluster.lastCol, cluster.firstRow + offset), glm::ivec2(cluster.lastCol + 1, cluster.firstRow + offset)) :
+			std::make_pair(glm::ivec2(cluster.firstCol + offset, cluster.lastRow), glm::ivec2(cluster.firstCol + offset, cluster.lastRow + 1));
+	};
+	auto add_transition = [&](const int offset)
+	{
+		const auto [first_tile, second_tile] = side_tiles(offset);
+		const int first = GetOrCreateNode(grid, grid.GetIndex(first_tile.x, first_tile.y));
+		const int second = GetOrCreateNode(grid, grid.GetIndex(second_tile.x, second_tile.y));
+		m_nodes[first].edges.push_back({ second, NavigationGrid::STRAIGHT_COST, true });
+		m_nodes[second].edges.push_back({ first, NavigationGrid::STRAIGHT_COST, true });
+		m_borders[border].emplace_back(first, second);
+	};
+
+	int run_start = -1;
+	for (int offset = 0; offset <= length; ++offset)
+	{
+		bool open = false;
+		if (offset < length)
+		{
+			const auto [first_tile, second_tile] = side_tiles(offset);
+			open = !grid.IsBlocked(first_tile.x, first_tile.y) && !grid.IsBlocked(second_tile.x, second_tile.y);
+		}
+
+		if (open && run_start < 0)
+		{
+			run_start = offset;
+		}
+		else if (!open && run_start >= 0)
+		{
+			const int run_end = offset - 1;
+			if (run_end - run_start + 1 < LONG_ENTRANCE)
+			{
+				add_transition((run_start + run_end) / 2);
+			}
+			else
+			{
+				add_transition(run_start);
+				add_transition(run_end);
+			}
+			run_start = -1;
+		}
+	}
+}
+
+void HierarchicalPathFinder::BuildClusterEdges(const NavigationGrid& grid, const int cluster)
+{
+	const auto& nodes = m_clusters[cluster].nodes;
+	for (const auto node : nodes)
+	{
+		auto& edges = m_nodes[node].edges;
+		edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& edge) { return !edge.crossesBorder; }), edges.end());
+	}
+
+	for (const auto node : nodes)
+	{
+		SearchCluster(grid, cluster, m_nodes[node].tile, -1);
+		for (const auto other : nodes)
+		{
+			if (other != node && WasReached(m_nodes[other].tile))
+			{
+				m_nodes[node].edges.push_back({ other, m_localCost[m_nodes[other].tile], false });
+			}
+		}
+	}
+}
+
+void HierarchicalPathFinder::SearchCluster(const NavigationGrid& grid, const int cluster, const int source_tile, const int goal_tile)
+{
+	if (++m_localGeneration == 0)
+	{
+		std::fill(m_localStamp.begin(), m_localStamp.end(), 0);
+		std::fill(m_localClosedStamp.begin(), m_localClosedStamp.end(), 0);
+		m_localGeneration = 1;
+	}
+
+	const auto& bounds = m_clusters[cluster];
+	const auto greater_cost = [](const OpenEntry& a, const OpenEntry& b) { return a.estimatedCost > b.estimatedCost; };
+
+	m_localOpen.clear();
+	m_localStamp[source_tile] = m_localGeneration;
+	m_localCost[source_tile] = 0.0f;
+	m_localParent[source_tile] = -1;
+	m_localOpen.push_back({ 0.0f, source_tile });
+
+	while (!m_localOpen.empty())
+	{
+		std::pop_heap(m_localOpen.begin(), m_localOpen.end(), greater_cost);
+		const int current = m_localOpen.back().id;
+		m_localOpen.pop_back();
+		if (m_localClosedStamp[current] == m_localGeneration)
+		{
+			continue;
+		}
+		m_localClosedStamp[current] = m_localGeneration;
+		if (current == goal_tile)
+		{
+			return;
+		}
+
+		const auto position = grid.GetTile(current);
+		for (int i = 0; i < 8; ++i)
+		{
+			const int col = position.x + NavigationGrid::NEIGHBOUR_COLS[i];
+			const int row = position.y + NavigationGrid::NEIGHBOUR_ROWS[i];
+			if (col < bounds.firstCol || col > bounds.lastCol || row < bounds.firstRow || row > bounds.lastRow ||
+				!grid.CanStep(position.x, position.y, NavigationGrid::NEIGHBOUR_COLS[i], NavigationGrid::NEIGHBOUR_ROWS[i]))
+			{
+				continue;
+			}
+
+			const int neighbour = grid.GetIndex(col, row);
+			const float cost = m_localCost[current] + (i < 4 ? NavigationGrid::STRAIGHT_COST : NavigationGrid::DIAGONAL_COST);
+			if (m_localClosedStamp[neighbour] == m_localGeneration ||
+				(m_localStamp[neighbour] == m_localGeneration && cost >= m_localCost[neighbour]))
+			{
+				continue;
+			}
+			m_localStamp[neighbour] = m_localGeneration;
+			m_localCost[neighbour] = cost;
+			m_localParent[neighbour] = current;
+			m_localOpen.push_back({ cost, neighbour });
+			std::push_heap(m_localOpen.begin(), m_localOpen.end(), greater_cost);
+		}
+	}
+}
+
+bool HierarchicalPathFinder::WasReached(const int tile) const
+{
+	return m_localStamp[tile] == m_localGeneration;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef __HIERARCHICAL_PATH_FINDER__
+#define __HIERARCHICAL_PATH_FINDER__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Heuristic.h"
+#include "NavigationGrid.h"
+
+/*
+ * HPA* over a NavigationGrid. The grid is split into square clusters; open stretches of the border between
+ * two clusters become entrances, each a pair of abstract nodes joined by a one tile step, and the nodes of
+ * a cluster are joined by their precomputed in-cluster distances. A query links start and goal into that
+ * small graph, searches it, and returns waypoints; each leg between waypoints stays inside one cluster and
+ * is only turned into tiles when RefineSegment is asked for it. Movement is 8-way without corner cutting.
+ */
+class HierarchicalPathFinder
+{
+public:
+	HierarchicalPathFinder();
+	~HierarchicalPathFinder();
+
+	void Build(const NavigationGrid& grid, int cluster_size = 10);
+
+	// call after changing one tile, only the clusters whose entrances or distances it affects are rebuilt
+	void TileChanged(const NavigationGrid& grid, int col, int row);
+
+	/*
+	 * Fills waypoints with start, the abstract nodes on the way and goal. Consecutive waypoints are always
+	 * either neighbours or in the same cluster. Returns false when there is no path
+	 */
+	bool FindAbstractPath(const NavigationGrid& grid, glm::ivec2 start, glm::ivec2 goal, Heuristic heuristic, std::vector<glm::ivec2>& waypoints);
+
+	// appends the tiles after from up to and including to, for two consecutive waypoints
+	bool RefineSegment(const NavigationGrid& grid, glm::ivec2 from, glm::ivec2 to, std::vector<glm::ivec2>& path);
+
+	// FindAbstractPath followed by refining every leg, path gets every tile from start to goal
+	bool FindPath(const NavigationGrid& grid, glm::ivec2 start, glm::ivec2 goal, Heuristic heuristic, std::vector<glm::ivec2>& path);
+
+	[[nodiscard]] int GetClusterSize() const;
+	[[nodiscard]] int GetAbstractNodeCount() const;
+
+	/*
+	 * Times the same random long-range queries against PathFinder and this and prints the results
+	 */
+	static void RunBenchmark(int cols, int rows, float blocked_ratio, int query_count, unsigned int seed);
+
+private:
+	struct Edge
+	{
+		int to;
+		float cost;
+		bool crossesBorder;
+	};
+
+	struct AbstractNode
+	{
+		int tile;
+		int cluster;
+		bool alive;
+		std::vector<Edge> edges;
+	};
+
+	struct Cluster
+	{
+		int firstCol;
+		int firstRow;
+		int lastCol;
+		int lastRow;
+		std::vector<int> nodes;
+	};
+
+	struct OpenEntry
+	{
+		float estimatedCost;
+		int id;
+	};
+
+	[[nodiscard]] int GetClusterIndex(int col, int row) const;
+	int GetOrCreateNode(const NavigationGrid& grid, int tile);
+	void RemoveNode(int node);
+
+	// border between cluster (cluster_col, cluster_row) and the one to its right or below it
+	[[nodiscard]] int GetBorderIndex(int cluster_col, int cluster_row, bool vertical) const;
+	void ClearBorder(int border);
+	void BuildBorder(const NavigationGrid& grid, int cluster_col, int cluster_row, bool vertical);
+	void BuildClusterEdges(const NavigationGrid& grid, int cluster);
+
+	// Dijkstra from source_tile confined to one cluster, stops once goal_tile is settled if it is not -1
+	void SearchCluster(const NavigationGrid& grid, int cluster, int source_tile, int goal_tile);
+	[[nodiscard]] bool WasReached(int tile) const;
+
+	int m_clusterSize;
+	int m_clusterCols;
+	int m_clusterRows;
+	std::vector<Cluster> m_clusters;
+	std::vector<AbstractNode> m_nodes;
+	std::vector<int> m_freeNodes;
+	std::vector<int> m_nodeAtTile;
+	// node pairs of every entrance, vertical borders first and then horizontal ones
+	std::vector<std::vector<std::pair<int, int>>> m_borders;
+
+	// in-cluster search scratch, stamped per search
+	std::vector<float> m_localCost;
+	std::vector<int> m_localParent;
+	std::vector<uint32_t> m_localStamp;
+	std::vector<uint32_t> m_localClosedStamp;
+	uint32_t m_localGeneration;
+	std::vector<OpenEntry> m_localOpen;
+
+	// abstract search scratch, ids past the last node are the temporary start and goal
+	std::vector<float> m_abstractCost;
+	std::vector<int> m_abstractParent;
+	std::vector<uint32_t> m_abstractStamp;
+	std::vector<uint32_t> m_abstractClosedStamp;
+	uint32_t m_abstractGeneration;
+	std::vector<OpenEntry> m_abstractOpen;
+	std::vector<Edge> m_startEdges;
+	std::vector<float> m_goalCostByNode;
+	std::vector<int> m_goalLinkedNodes;
+	std::vector<glm::ivec2> m_waypoints;
+};
+
+#endif /* defined (__HIERARCHICAL_PATH_FINDER__) */
@@ -4,16 +4,16 @@
 Label::Label(const std::string& text, const std::string& font_name, const int font_size, const SDL_Color colour, const glm::vec2 position, const int font_style, const bool is_centered):
 	m_fontColour(colour), m_fontName(font_name), m_text(text), m_isCentered(is_centered), m_fontSize(font_size), m_fontStyle(font_style)
 {
-	m_fontPath = "../Assets/fonts/" + font_name + ".ttf";
+	m_fontPath = FontPath(font_name);
 
 	BuildFontID();
 
 	// Load font, convert Label String to Texture and store in TextureManager
 	FontManager::Instance().Load(m_fontPath, m_fontID, font_size, font_style);
-	FontManager::Instance().TextToTexture(text, m_fontID, m_fontID, colour);
+	FontManager::Instance().TextToTexture(text, m_font, m_texture, colour);
 
 	// set Size of Label Object based on computed Texture Size 
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 
@@ -27,7 +27,7 @@ Label::~Label()
 void Label::Draw()
 {
 	// draw the label
-	TextureManager::Instance().DrawText(m_fontID, GetTransform()->position, 0, 255, m_isCentered);
+	TextureManager::Instance().Draw(m_texture, GetTransform()->position, 0, 255, m_isCentered);
 }
 
 void Label::Update()
@@ -48,8 +48,8 @@ void Label::SetText(const std::string& new_text)
 	BuildFontID();
 
 	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance().TextToTexture(new_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
+	FontManager::Instance().TextToTexture(new_text, m_font, m_texture, m_fontColour);
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 }
@@ -61,7 +61,7 @@ void Label::SetText(const std::string& new_text)
 void Label::SetColour(const SDL_Color new_colour) const
 {
 	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance().TextToTexture(m_text, m_fontID, m_fontID, new_colour);
+	FontManager::Instance().TextToTexture(m_text, m_font, m_texture, new_colour);
 }
 
 /**
@@ -74,22 +74,31 @@ void Label::SetSize(const int new_size)
 
 	BuildFontID();
 	
-	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, TTF_STYLE_NORMAL);
-	FontManager::Instance().TextToTexture(m_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().GetTextureSize(m_fontID);
+	FontManager::Instance().Load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
+	FontManager::Instance().TextToTexture(m_text, m_font, m_texture, m_fontColour);
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 }
 
+std::string Label::FontPath(const std::string& font_name)
+{
+	return "../Assets/fonts/" + font_name + ".ttf";
+}
+
+std::string Label::FontID(const std::string& font_name, const int font_size, const int font_style)
+{
+	return font_name + "-" + std::to_string(font_size) + "-" + std::to_string(font_style);
+}
+
 /**
- * \brief Private function that builds a font id to be used with TextureManager
+ * \brief Private function that builds the font id and the id of the texture holding the text
  */
 void Label::BuildFontID()
 {
-	m_fontID = m_fontName;
-	m_fontID += "-";
-	m_fontID += std::to_string(m_fontSize);
-	m_fontID += "-";
-	m_fontID += m_text;
-}
+	// labels of the same font, size and style share one open font, only the texture is per text
+	m_fontID = FontID(m_fontName, m_fontSize, m_fontStyle);
 
+	m_font = FontManager::Instance().GetFontHandle(m_fontID);
+	m_texture = TextureManager::Instance().GetTextureHandle(m_fontID + "-" + m_text);
+}
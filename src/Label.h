@@ -26,10 +26,17 @@ public:
 	void SetColour(SDL_Color new_colour) const;
 	void SetSize(int new_size);
 
+	// the file and font id a label opens, for scenes that list their fonts in an AssetManifest
+	static std::string FontPath(const std::string& font_name);
+	static std::string FontID(const std::string& font_name, int font_size, int font_style = TTF_STYLE_NORMAL);
+
 private:
 	// private data members
 	std::string m_fontPath;
 	std::string m_fontID;
+	// rebuilt with m_fontID, the texture also follows the text
+	FontHandle m_font;
+	TextureHandle m_texture;
 	SDL_Color m_fontColour;
 	std::string m_fontName;
 	std::string m_text;
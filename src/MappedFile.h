@@ -0,0 +1,39 @@
+#pragma once
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <cstddef>
+#include <string>
+
+/*
+ * Read only view of a whole file mapped into memory. Pages are read in by the OS the first time they are
+ * touched, so opening even a large file costs next to nothing
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// false if the file is missing or empty
+	bool Open(const std::string& file_name);
+	void Close();
+
+	[[nodiscard]] bool IsOpen() const;
+	[[nodiscard]] const char* GetData() const;
+	[[nodiscard]] size_t GetSize() const;
+
+private:
+#ifdef _WIN32
+	void* m_file;
+	void* m_mapping;
+#else
+	int m_file;
+#endif
+	const char* m_data;
+	size_t m_size;
+};
+
+#endif /* defined (__MAPPED_FILE__) */
@@ -0,0 +1,176 @@
+#include "NavigationGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "DisplayObject.h"
+
+namespace
+{
+	// shared by every grid, so two grids never hand out the same version even at the same address
+	std::atomic<uint64_t> next_version{ 1 };
+}
+
+NavigationGrid::NavigationGrid(const int cols, const int rows) :
+	m_cols(cols), m_rows(rows), m_blocked(static_cast<size_t>(cols) * rows, 0), m_version(next_version++)
+{
+}
+
+NavigationGrid::~NavigationGrid()
+= default;
+
+int NavigationGrid::GetCols() const
+{
+	return m_cols;
+}
+
+int NavigationGrid::GetRows() const
+{
+	return m_rows;
+}
+
+int NavigationGrid::GetTileCount() const
+{
+	return m_cols * m_rows;
+}
+
+bool NavigationGrid::InBounds(const int col, const int row) const
+{
+	return col >= 0 && col < m_cols && row >= 0 && row < m_rows;
+}
+
+int NavigationGrid::GetIndex(const int col, const int row) const
+{
+	return row * m_cols + col;
+}
+
+glm::ivec2 NavigationGrid::GetTile(const int index) const
+{
+	return glm::ivec2(index % m_cols, index / m_cols);
+}
+
+bool NavigationGrid::IsBlocked(const int col, const int row) const
+{
+	// outside the grid counts as blocked so searches never leave it
+	return !InBounds(col, row) || m_blocked[GetIndex(col, row)] != 0;
+}
+
+bool NavigationGrid::IsBlocked(const int index) const
+{
+	return m_blocked[index] != 0;
+}
+
+bool NavigationGrid::CanStep(const int col, const int row, const int step_col, const int step_row) const
+{
+	if (IsBlocked(col + step_col, row + step_row))
+	{
+		return false;
+	}
+
+	// a diagonal step needs both tiles it passes between to be open
+	return step_col == 0 || step_row == 0 ||
+		(!IsBlocked(col + step_col, row) && !IsBlocked(col, row + step_row));
+}
+
+bool NavigationGrid::SetBlocked(const int col, const int row, const bool state)
+{
+	if (!InBounds(col, row) || (m_blocked[GetIndex(col, row)] != 0) == state)
+	{
+		return false;
+	}
+
+	m_blocked[GetIndex(col, row)] = state ? 1 : 0;
+	m_version = next_version++;
+	return true;
+}
+
+void NavigationGrid::ClearBlocked()
+{
+	std::fill(m_blocked.begin(), m_blocked.end(), static_cast<uint8_t>(0));
+	m_version = next_version++;
+}
+
+int NavigationGrid::BlockObstacles(const std::vector<DisplayObject*>& objects)
+{
+	int changed = 0;
+	for (const auto object : objects)
+	{
+		if (object == nullptr || object->GetType() != GameObjectType::OBSTACLE)
+		{
+			continue;
+		}
+
+		// obstacles are centered on their position
+		const auto half_size = glm::vec2(static_cast<float>(object->GetWidth()), static_cast<float>(object->GetHeight())) * 0.5f;
+		const auto first = GetTileAt(object->GetTransform()->position - half_size);
+		const auto last = GetTileAt(object->GetTransform()->position + half_size);
+		for (int row = std::max(first.y, 0); row <= std::min(last.y, m_rows - 1); ++row)
+		{
+			for (int col = std::max(first.x, 0); col <= std::min(last.x, m_cols - 1); ++col)
+			{
+				if (SetBlocked(col, row, true))
+				{
+					++changed;
+				}
+			}
+		}
+	}
+	return changed;
+}
+
+std::vector<int> NavigationGrid::BlockRandomly(const float blocked_ratio, std::mt19937& random_generator)
+{
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+	std::vector<int> open_tiles;
+	for (int row = 0; row < m_rows; ++row)
+	{
+		for (int col = 0; col < m_cols; ++col)
+		{
+			if (chance(random_generator) < blocked_ratio)
+			{
+				SetBlocked(col, row, true);
+			}
+			else
+			{
+				open_tiles.push_back(GetIndex(col, row));
+			}
+		}
+	}
+	return open_tiles;
+}
+
+float NavigationGrid::EstimateCost(const glm::ivec2 from, const glm::ivec2 to, const Heuristic heuristic, const bool allow_diagonals)
+{
+	const auto dx = static_cast<float>(std::abs(to.x - from.x));
+	const auto dy = static_cast<float>(std::abs(to.y - from.y));
+	switch (heuristic)
+	{
+	case EUCLIDEAN:
+		return std::sqrt(dx * dx + dy * dy) * STRAIGHT_COST;
+	case MANHATTAN:
+	default:
+		if (allow_diagonals)
+		{
+			return (dx + dy) * STRAIGHT_COST + (DIAGONAL_COST - 2.0f * STRAIGHT_COST) * std::min(dx, dy);
+		}
+		return (dx + dy) * STRAIGHT_COST;
+	}
+}
+
+uint64_t NavigationGrid::GetVersion() const
+{
+	return m_version;
+}
+
+glm::vec2 NavigationGrid::GetWorldPosition(const int col, const int row) const
+{
+	constexpr auto half_tile = Config::TILE_SIZE * 0.5f;
+	return glm::vec2(static_cast<float>(col * Config::TILE_SIZE) + half_tile, static_cast<float>(row * Config::TILE_SIZE) + half_tile);
+}
+
+glm::ivec2 NavigationGrid::GetTileAt(const glm::vec2 world_position) const
+{
+	return glm::ivec2(static_cast<int>(std::floor(world_position.x / Config::TILE_SIZE)),
+		static_cast<int>(std::floor(world_position.y / Config::TILE_SIZE)));
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef __NAVIGATION_GRID__
+#define __NAVIGATION_GRID__
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Config.h"
+#include "Heuristic.h"
+
+class DisplayObject;
+
+/*
+ * Walkability of the tile grid the pathfinders search. Tiles are TILE_SIZE pixels and stored row by row
+ * in one flat array, so a tile's index is row * cols + col. Defaults to the Config grid size.
+ */
+class NavigationGrid
+{
+public:
+	// step costs and neighbour offsets shared by every search over the grid, the four straight neighbours first
+	static constexpr float STRAIGHT_COST = static_cast<float>(Config::TILE_COST);
+	static constexpr float DIAGONAL_COST = Config::TILE_COST * 1.41421356f;
+	static constexpr int NEIGHBOUR_COLS[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	static constexpr int NEIGHBOUR_ROWS[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+	NavigationGrid(int cols = Config::COL_NUM, int rows = Config::ROW_NUM);
+	~NavigationGrid();
+
+	[[nodiscard]] int GetCols() const;
+	[[nodiscard]] int GetRows() const;
+	[[nodiscard]] int GetTileCount() const;
+	[[nodiscard]] bool InBounds(int col, int row) const;
+	[[nodiscard]] int GetIndex(int col, int row) const;
+	[[nodiscard]] glm::ivec2 GetTile(int index) const;
+
+	[[nodiscard]] bool IsBlocked(int col, int row) const;
+	[[nodiscard]] bool IsBlocked(int index) const;
+	// the target must be open, and a diagonal step may not cut past a blocked corner
+	[[nodiscard]] bool CanStep(int col, int row, int step_col, int step_row) const;
+	// returns true if the tile actually changed
+	bool SetBlocked(int col, int row, bool state);
+	void ClearBlocked();
+
+	// blocks every tile an OBSTACLE in objects overlaps, returns the number of tiles that changed
+	int BlockObstacles(const std::vector<DisplayObject*>& objects);
+	// blocks each tile with the chance blocked_ratio, for the benchmarks, and returns the indices of the open ones
+	std::vector<int> BlockRandomly(float blocked_ratio, std::mt19937& random_generator);
+
+	/*
+	 * Estimated cost between two tiles, never more than the real one. With diagonals MANHATTAN becomes the
+	 * octile distance, plain manhattan would overestimate once a diagonal step replaces two straight ones
+	 */
+	static float EstimateCost(glm::ivec2 from, glm::ivec2 to, Heuristic heuristic, bool allow_diagonals);
+
+	/*
+	 * Changed by every edit, caches built from the grid compare it to know when they are stale. Versions come
+	 * from one process wide counter, so no two grids share one and a copy keeps the version of its original
+	 */
+	[[nodiscard]] uint64_t GetVersion() const;
+
+	// centre of a tile in world space and the tile under a world position
+	[[nodiscard]] glm::vec2 GetWorldPosition(int col, int row) const;
+	[[nodiscard]] glm::ivec2 GetTileAt(glm::vec2 world_position) const;
+
+private:
+	int m_cols;
+	int m_rows;
+	std::vector<uint8_t> m_blocked;
+	uint64_t m_version;
+};
+
+#endif /* defined (__NAVIGATION_GRID__) */
@@ -7,8 +7,9 @@
 Obstacle::Obstacle()
 {
 	TextureManager::Instance().Load("../Assets/textures/obstacle.png", "obstacle");
+	m_texture = TextureManager::Instance().GetTextureHandle("obstacle");
 
-	const auto size = TextureManager::Instance().GetTextureSize("obstacle");
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 
@@ -25,7 +26,7 @@ Obstacle::~Obstacle()
 
 void Obstacle::Draw()
 {
-	TextureManager::Instance().Draw("obstacle", GetTransform()->position, 0, 255, true);
+	TextureManager::Instance().Draw(m_texture, GetTransform()->position, 0, 255, true);
 }
 
 void Obstacle::Update()
@@ -1,6 +1,7 @@
 #pragma once
 #ifndef __OBSTACLE__
 #define __OBSTACLE__
+#include "AssetRegistry.h"
 #include "DisplayObject.h"
 
 class Obstacle final : public DisplayObject
@@ -17,7 +18,7 @@ public:
 	void Update() override;
 	void Clean() override;
 private:
-	
+	TextureHandle m_texture;
 };
 
 #endif /* defined (__OBSTACLE__) */
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "ObstacleGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "CollisionManager.h"
+#include "DisplayObject.h"
+
+ObstacleGrid::ObstacleGrid() : m_cellStart(CELL_COUNT + 1, 0), m_currentStamp(0)
+{
+}
+
+ObstacleGrid::~ObstacleGrid()
+= default;
+
+void ObstacleGrid::Build(const std::vector<DisplayObject*>& objects)
+{
+	Clear();
+
+	for (const auto object : objects)
+	{
+		if (object == nullptr || object->GetType() != GameObjectType::OBSTACLE)
+		{
+			continue;
+		}
+
+		// obstacles are centered on their position, the same as CollisionManager::LOSCheck
+		const auto half_size = glm::vec2(static_cast<float>(object->GetWidth()), static_cast<float>(object->GetHeight())) * 0.5f;
+		m_boxMin.push_back(object->GetTransform()->position - half_size);
+		m_boxMax.push_back(object->GetTransform()->position + half_size);
+	}
+
+	const int obstacle_count = GetObstacleCount();
+	m_testedStamp.assign(obstacle_count, 0);
+	m_currentStamp = 0;
+
+	constexpr auto world_width = static_cast<float>(Config::COL_NUM * Config::TILE_SIZE);
+	constexpr auto world_height = static_cast<float>(Config::ROW_NUM * Config::TILE_SIZE);
+
+	// cell ranges of every obstacle, clamped to the grid
+	std::vector<int> first_col(obstacle_count), last_col(obstacle_count), first_row(obstacle_count), last_row(obstacle_count);
+	for (int i = 0; i < obstacle_count; ++i)
+	{
+		if (m_boxMin[i].x < 0.0f || m_boxMin[i].y < 0.0f || m_boxMax[i].x > world_width || m_boxMax[i].y > world_height)
+		{
+			m_outsideObstacles.push_back(i);
+		}
+
+		first_col[i] = std::clamp(static_cast<int>(std::floor(m_boxMin[i].x / Config::TILE_SIZE)), 0, Config::COL_NUM - 1);
+		last_col[i] = std::clamp(static_cast<int>(std::floor(m_boxMax[i].x / Config::TILE_SIZE)), 0, Config::COL_NUM - 1);
+		first_row[i] = std::clamp(static_cast<int>(std::floor(m_boxMin[i].y / Config::TILE_SIZE)), 0, Config::ROW_NUM - 1);
+		last_row[i] = std::clamp(static_cast<int>(std::floor(m_boxMax[i].y / Config::TILE_SIZE)), 0, Config::ROW_NUM - 1);
+
+		// entirely off the grid, the outside list covers it
+		if (m_boxMax[i].x < 0.0f || m_boxMax[i].y < 0.0f || m_boxMin[i].x > world_width || m_boxMin[i].y > world_height)
+		{
+			last_col[i] = first_col[i] - 1;
+		}
+	}
+
+	// count, prefix sum, then fill, so the cells share one flat array
+	for (int i = 0; i < obstacle_count; ++i)
+	{
+		for (int row = first_row[i]; row <= last_row[i]; ++row)
+		{
+			for (int col = first_col[i]; col <= last_col[i]; ++col)
+			{
+				++m_cellStart[row * Config::COL_NUM + col + 1];
+			}
+		}
+	}
+
+	for (int cell = 0; cell < CELL_COUNT; ++cell)
+	{
+		m_cellStart[cell + 1] += m_cellStart[cell];
+	}
+
+	m_cellObstacles.resize(m_cellStart[CELL_COUNT]);
+	std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+	for (int i = 0; i < obstacle_count; ++i)
+	{
+		for (int row = first_row[i]; row <= last_row[i]; ++row)
+		{
+			for (int col = first_col[i]; col <= last_col[i]; ++col)
+			{
+				m_cellObstacles[fill[row * Config::COL_NUM + col]++] = i;
+			}
+		}
+	}
+}
+
+void ObstacleGrid::Clear()
+{
+	m_boxMin.clear();
+	m_boxMax.clear();
+	std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+	m_cellObstacles.clear();
+	m_outsideObstacles.clear();
+	m_testedStamp.clear();
+}
+
+bool ObstacleGrid::SegmentBlocked(const glm::vec2 line_start, const glm::vec2 line_end) const
+{
+	if (m_boxMin.empty())
+	{
+		return false;
+	}
+
+	// new stamp for this query, wrapping around resets every stamp so old ones can't match
+	if (++m_currentStamp == 0)
+	{
+		std::fill(m_testedStamp.begin(), m_testedStamp.end(), 0);
+		m_currentStamp = 1;
+	}
+
+	constexpr auto world_width = static_cast<float>(Config::COL_NUM * Config::TILE_SIZE);
+	constexpr auto world_height = static_cast<float>(Config::ROW_NUM * Config::TILE_SIZE);
+	const auto world_max = glm::vec2(world_width, world_height);
+
+	const bool leaves_grid =
+		std::min(line_start.x, line_end.x) < 0.0f || std::min(line_start.y, line_end.y) < 0.0f ||
+		std::max(line_start.x, line_end.x) > world_width || std::max(line_start.y, line_end.y) > world_height;
+	if (leaves_grid)
+	{
+		for (const auto obstacle : m_outsideObstacles)
+		{
+			if (TestObstacle(obstacle, line_start, line_end))
+			{
+				return true;
+			}
+		}
+	}
+
+	// clip the segment to the grid, t_enter and t_exit are fractions of the segment
+	const auto direction = line_end - line_start;
+	float t_enter = 0.0f;
+	float t_exit = 1.0f;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (direction[axis] == 0.0f)
+		{
+			if (line_start[axis] < 0.0f || line_start[axis] > world_max[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+		const float t1 = (0.0f - line_start[axis]) / direction[axis];
+		const float t2 = (world_max[axis] - line_start[axis]) / direction[axis];
+		t_enter = std::max(t_enter, std::min(t1, t2));
+		t_exit = std::min(t_exit, std::max(t1, t2));
+	}
+	if (t_enter > t_exit)
+	{
+		return false;
+	}
+
+	// Amanatides-Woo traversal: step into whichever neighbouring column or row the segment reaches first
+	const auto entry = line_start + direction * t_enter;
+	int col = std::clamp(static_cast<int>(std::floor(entry.x / Config::TILE_SIZE)), 0, Config::COL_NUM - 1);
+	int row = std::clamp(static_cast<int>(std::floor(entry.y / Config::TILE_SIZE)), 0, Config::ROW_NUM - 1);
+
+	constexpr float infinity = std::numeric_limits<float>::infinity();
+	const int step_col = direction.x > 0.0f ? 1 : -1;
+	const int step_row = direction.y > 0.0f ? 1 : -1;
+	const float t_delta_col = direction.x != 0.0f ? Config::TILE_SIZE / std::abs(direction.x) : infinity;
+	const float t_delta_row = direction.y != 0.0f ? Config::TILE_SIZE / std::abs(direction.y) : infinity;
+	float t_max_col = direction.x != 0.0f ?
+		(static_cast<float>((col + (step_col > 0 ? 1 : 0)) * Config::TILE_SIZE) - line_start.x) / direction.x : infinity;
+	float t_max_row = direction.y != 0.0f ?
+		(static_cast<float>((row + (step_row > 0 ? 1 : 0)) * Config::TILE_SIZE) - line_start.y) / direction.y : infinity;
+
+	while (true)
+	{
+		const int cell = row * Config::COL_NUM + col;
+		for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+		{
+			if (TestObstacle(m_cellObstacles[i], line_start, line_end))
+			{
+				return true;
+			}
+		}
+
+		if (t_max_col < t_max_row)
+		{
+			if (t_max_col > t_exit)
+			{
+				break;
+			}
+			col += step_col;
+			t_max_col += t_delta_col;
+		}
+		else
+		{
+			if (t_max_row > t_exit)
+			{
+				break;
+			}
+			row += step_row;
+			t_max_row += t_delta_row;
+		}
+
+		if (col < 0 || col >= Config::COL_NUM || row < 0 || row >= Config::ROW_NUM)
+		{
+			break;
+		}
+	}
+
+	return false;
+}
+
+int ObstacleGrid::GetObstacleCount() const
+{
+	return static_cast<int>(m_boxMin.size());
+}
+
+bool ObstacleGrid::TestObstacle(const int obstacle, const glm::vec2 line_start, const glm::vec2 line_end) const
+{
+	if (m_testedStamp[obstacle] == m_currentStamp)
+	{
+		return false;
+	}
+	m_testedStamp[obstacle] = m_currentStamp;
+
+	return CollisionManager::LineAABBSlabCheck(line_start, line_end, m_boxMin[obstacle], m_boxMax[obstacle]);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef __OBSTACLE_GRID__
+#define __OBSTACLE_GRID__
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Config.h"
+
+class DisplayObject;
+
+/*
+ * Occupancy grid of obstacle boxes over the Config tile grid (COL_NUM x ROW_NUM tiles of TILE_SIZE).
+ * A segment is walked cell by cell with a DDA, so only the obstacles in the cells it crosses are tested
+ * exactly and a query costs time in proportion to the length of the segment, not the number of obstacles.
+ * Rebuild it whenever obstacles are added, removed or moved.
+ */
+class ObstacleGrid
+{
+public:
+	ObstacleGrid();
+	~ObstacleGrid();
+
+	// stores every OBSTACLE in objects, other types are ignored
+	void Build(const std::vector<DisplayObject*>& objects);
+	void Clear();
+
+	// true if the segment touches any stored obstacle
+	[[nodiscard]] bool SegmentBlocked(glm::vec2 line_start, glm::vec2 line_end) const;
+
+	[[nodiscard]] int GetObstacleCount() const;
+
+private:
+	static constexpr int CELL_COUNT = Config::COL_NUM * Config::ROW_NUM;
+
+	bool TestObstacle(int obstacle, glm::vec2 line_start, glm::vec2 line_end) const;
+
+	// obstacle boxes
+	std::vector<glm::vec2> m_boxMin;
+	std::vector<glm::vec2> m_boxMax;
+
+	// obstacles per cell, cell c owns m_cellObstacles[m_cellStart[c] .. m_cellStart[c + 1])
+	std::vector<int> m_cellStart;
+	std::vector<int> m_cellObstacles;
+	// obstacles reaching outside the grid are tested by every query
+	std::vector<int> m_outsideObstacles;
+
+	// an obstacle spanning several cells is only tested once per query
+	mutable std::vector<uint32_t> m_testedStamp;
+	mutable uint32_t m_currentStamp;
+};
+
+#endif /* defined (__OBSTACLE_GRID__) */
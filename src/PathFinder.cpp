@@ -0,0 +1,224 @@
+#include "PathFinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+PathFinder::PathFinder() : m_generation(0), m_allowDiagonals(false), m_lastExpandedCount(0)
+{
+}
+
+PathFinder::~PathFinder()
+= default;
+
+bool PathFinder::FindPath(const NavigationGrid& grid, const glm::ivec2 start, const glm::ivec2 goal, const Heuristic heuristic, std::vector<glm::ivec2>& path)
+{
+	path.clear();
+	m_lastExpandedCount = 0;
+
+	if (grid.IsBlocked(start.x, start.y) || grid.IsBlocked(goal.x, goal.y))
+	{
+		return false;
+	}
+
+	Prepare(grid.GetTileCount());
+
+	const int start_tile = grid.GetIndex(start.x, start.y);
+	const int goal_tile = grid.GetIndex(goal.x, goal.y);
+	const int neighbour_count = m_allowDiagonals ? 8 : 4;
+
+	m_costSoFar[start_tile] = 0.0f;
+	m_parent[start_tile] = -1;
+	m_openedStamp[start_tile] = m_generation;
+	PushOpen(NavigationGrid::EstimateCost(start, goal, heuristic, m_allowDiagonals), start_tile);
+
+	bool found = false;
+	while (!m_open.empty())
+	{
+		const int current = PopOpen();
+		if (m_closedStamp[current] == m_generation)
+		{
+			continue;
+		}
+		m_closedStamp[current] = m_generation;
+		++m_lastExpandedCount;
+
+		if (current == goal_tile)
+		{
+			found = true;
+			break;
+		}
+
+		const auto current_position = grid.GetTile(current);
+		for (int i = 0; i < neighbour_count; ++i)
+		{
+			const int col = current_position.x + NavigationGrid::NEIGHBOUR_COLS[i];
+			const int row = current_position.y + NavigationGrid::NEIGHBOUR_ROWS[i];
+			if (!grid.CanStep(current_position.x, current_position.y, NavigationGrid::NEIGHBOUR_COLS[i], NavigationGrid::NEIGHBOUR_ROWS[i]))
+			{
+				continue;
+			}
+
+			const int neighbour = grid.GetIndex(col, row);
+			if (m_closedStamp[neighbour] == m_generation)
+			{
+				continue;
+			}
+
+			const float cost = m_costSoFar[current] + (i < 4 ? NavigationGrid::STRAIGHT_COST : NavigationGrid::DIAGONAL_COST);
+			if (m_openedStamp[neighbour] != m_generation || cost < m_costSoFar[neighbour])
+			{
+				m_openedStamp[neighbour] = m_generation;
+				m_costSoFar[neighbour] = cost;
+				m_parent[neighbour] = current;
+				PushOpen(cost + NavigationGrid::EstimateCost(glm::ivec2(col, row), goal, heuristic, m_allowDiagonals), neighbour);
+			}
+		}
+	}
+
+	m_open.clear();
+	if (!found)
+	{
+		return false;
+	}
+
+	for (int tile = goal_tile; tile != -1; tile = m_parent[tile])
+	{
+		path.push_back(grid.GetTile(tile));
+	}
+	std::reverse(path.begin(), path.end());
+	return true;
+}
+
+void PathFinder::SetAllowDiagonals(const bool state)
+{
+	m_allowDiagonals = state;
+}
+
+bool PathFinder::GetAllowDiagonals() const
+{
+	return m_allowDiagonals;
+}
+
+int PathFinder::GetLastExpandedCount() const
+{
+	return m_lastExpandedCount;
+}
+
+void PathFinder::RunBenchmark(const int cols, const int rows, const float blocked_ratio, const int query_count, const unsigned int seed)
+{
+	std::mt19937 random_generator(seed);
+	NavigationGrid grid(cols, rows);
+	const auto open_tiles = grid.BlockRandomly(blocked_ratio, random_generator);
+
+	if (open_tiles.size() < 2)
+	{
+		std::cout << "Pathfinding benchmark: map has no open tiles" << std::endl;
+		return;
+	}
+
+	// the same queries for every heuristic
+	std::uniform_int_distribution<size_t> pick(0, open_tiles.size() - 1);
+	std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+	for (int i = 0; i < query_count; ++i)
+	{
+		queries.emplace_back(grid.GetTile(open_tiles[pick(random_generator)]), grid.GetTile(open_tiles[pick(random_generator)]));
+	}
+
+	std::cout << "Pathfinding benchmark: " << cols << "x" << rows << " tiles, " << blocked_ratio * 100.0f
+		<< "% blocked, " << query_count << " queries" << std::endl;
+
+	PathFinder path_finder;
+	std::vector<glm::ivec2> path;
+	for (int heuristic = 0; heuristic < NUM_OF_HEURISTICS; ++heuristic)
+	{
+		int found = 0;
+		long long expanded = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (const auto& query : queries)
+		{
+			if (path_finder.FindPath(grid, query.first, query.second, static_cast<Heuristic>(heuristic), path))
+			{
+				++found;
+			}
+			expanded += path_finder.GetLastExpandedCount();
+		}
+		const auto microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << (heuristic == MANHATTAN ? "  MANHATTAN: " : "  EUCLIDEAN: ")
+			<< found << " found, " << microseconds / query_count << " us per query, "
+			<< static_cast<double>(expanded) / query_count << " tiles expanded per query" << std::endl;
+	}
+}
+
+void PathFinder::Prepare(const int tile_count)
+{
+	if (static_cast<int>(m_costSoFar.size()) < tile_count)
+	{
+		m_costSoFar.resize(tile_count);
+		m_parent.resize(tile_count);
+		m_openedStamp.resize(tile_count, 0);
+		m_closedStamp.resize(tile_count, 0);
+	}
+
+	// a new generation makes every stamp stale, only on wrap around do they really need clearing
+	if (++m_generation == 0)
+	{
+		std::fill(m_openedStamp.begin(), m_openedStamp.end(), 0);
+		std::fill(m_closedStamp.begin(), m_closedStamp.end(), 0);
+		m_generation = 1;
+	}
+
+	m_open.clear();
+}
+
+void PathFinder::PushOpen(const float estimated_cost, const int tile)
+{
+	m_open.push_back({ estimated_cost, tile });
+
+	// sift up
+	auto index = m_open.size() - 1;
+	while (index > 0)
+	{
+		const auto parent = (index - 1) / 2;
+		if (m_open[parent].estimatedCost <= m_open[index].estimatedCost)
+		{
+			break;
+		}
+		std::swap(m_open[parent], m_open[index]);
+		index = parent;
+	}
+}
+
+int PathFinder::PopOpen()
+{
+	const int tile = m_open.front().tile;
+	m_open.front() = m_open.back();
+	m_open.pop_back();
+
+	// sift down
+	const auto size = m_open.size();
+	size_t index = 0;
+	while (true)
+	{
+		const auto left = index * 2 + 1;
+		const auto right = left + 1;
+		auto smallest = index;
+		if (left < size && m_open[left].estimatedCost < m_open[smallest].estimatedCost)
+		{
+			smallest = left;
+		}
+		if (right < size && m_open[right].estimatedCost < m_open[smallest].estimatedCost)
+		{
+			smallest = right;
+		}
+		if (smallest == index)
+		{
+			break;
+		}
+		std::swap(m_open[index], m_open[smallest]);
+		index = smallest;
+	}
+	return tile;
+}
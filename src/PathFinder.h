@@ -0,0 +1,71 @@
+#pragma once
+#ifndef __PATH_FINDER__
+#define __PATH_FINDER__
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Heuristic.h"
+#include "NavigationGrid.h"
+
+/*
+ * A* over a NavigationGrid. The per-tile search state lives in flat arrays that are stamped with a
+ * generation number instead of being cleared, and the open list is a binary heap, so once the arrays
+ * have grown to the grid size a query does not allocate. Keep one PathFinder per thread.
+ */
+class PathFinder
+{
+public:
+	PathFinder();
+	~PathFinder();
+
+	/*
+	 * Fills path with the tiles from start to goal, both included. Returns false and leaves path empty
+	 * when either end is blocked or the goal can't be reached
+	 */
+	bool FindPath(const NavigationGrid& grid, glm::ivec2 start, glm::ivec2 goal, Heuristic heuristic, std::vector<glm::ivec2>& path);
+
+	/*
+	 * Diagonal steps cost TILE_COST * sqrt(2) and may not cut past a blocked corner, off by default.
+	 * With diagonals the MANHATTAN heuristic becomes the octile distance so it never overestimates
+	 */
+	void SetAllowDiagonals(bool state);
+	[[nodiscard]] bool GetAllowDiagonals() const;
+
+	// tiles taken off the open list by the last FindPath
+	[[nodiscard]] int GetLastExpandedCount() const;
+
+	/*
+	 * Times query_count random queries per heuristic on a random map with the given share of blocked tiles
+	 * and prints the results
+	 */
+	static void RunBenchmark(int cols, int rows, float blocked_ratio, int query_count, unsigned int seed);
+
+private:
+	struct OpenEntry
+	{
+		float estimatedCost;
+		int tile;
+	};
+
+	void Prepare(int tile_count);
+	void PushOpen(float estimated_cost, int tile);
+	int PopOpen();
+
+	// search state, valid only where the stamp matches m_generation
+	std::vector<float> m_costSoFar;
+	std::vector<int> m_parent;
+	std::vector<uint32_t> m_openedStamp;
+	std::vector<uint32_t> m_closedStamp;
+	uint32_t m_generation;
+
+	// binary min-heap on estimatedCost, stale entries are skipped when popped
+	std::vector<OpenEntry> m_open;
+
+	bool m_allowDiagonals;
+	int m_lastExpandedCount;
+};
+
+#endif /* defined (__PATH_FINDER__) */
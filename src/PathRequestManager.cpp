@@ -0,0 +1,208 @@
+#include "PathRequestManager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "PathFinder.h"
+
+namespace
+{
+	constexpr int DEFAULT_FRAME_BUDGET = 16;
+}
+
+PathRequestManager::PathRequestManager() :
+	m_snapshotVersion(0), m_nextTicket(INVALID_TICKET + 1),
+	m_frameBudget(DEFAULT_FRAME_BUDGET), m_workerCount(0), m_running(false)
+{
+	// leave a core for the main thread
+	const int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+	m_workerCount = std::max(hardware_threads - 1, 1);
+}
+
+PathRequestManager::~PathRequestManager()
+{
+	Shutdown();
+}
+
+void PathRequestManager::SetNavigationGrid(const NavigationGrid& grid)
+{
+	if (m_snapshot != nullptr && m_snapshotVersion == grid.GetVersion())
+	{
+		return;
+	}
+
+	m_snapshot = std::make_shared<const NavigationGrid>(grid);
+	m_snapshotVersion = grid.GetVersion();
+}
+
+PathTicket PathRequestManager::Submit(const glm::ivec2 start, const glm::ivec2 goal, const Heuristic heuristic, PathCallback callback)
+{
+	if (m_snapshot == nullptr)
+	{
+		return INVALID_TICKET;
+	}
+	if (!m_running)
+	{
+		StartWorkers();
+	}
+
+	const PathTicket ticket = m_nextTicket++;
+	if (m_nextTicket == INVALID_TICKET)
+	{
+		m_nextTicket = INVALID_TICKET + 1;
+	}
+	m_callbacks[ticket] = std::move(callback);
+
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		m_requests.push_back({ ticket, m_snapshot, start, goal, heuristic });
+	}
+	m_requestCondition.notify_one();
+	return ticket;
+}
+
+void PathRequestManager::Cancel(const PathTicket ticket)
+{
+	if (m_callbacks.erase(ticket) == 0)
+	{
+		return;
+	}
+
+	// skip the search too if no worker has picked it up yet
+	std::lock_guard<std::mutex> lock(m_requestMutex);
+	const auto it = std::find_if(m_requests.begin(), m_requests.end(), [ticket](const Request& request)
+	{
+		return request.ticket == ticket;
+	});
+	if (it != m_requests.end())
+	{
+		m_requests.erase(it);
+	}
+}
+
+bool PathRequestManager::IsPending(const PathTicket ticket) const
+{
+	return m_callbacks.find(ticket) != m_callbacks.end();
+}
+
+int PathRequestManager::GetPendingCount() const
+{
+	return static_cast<int>(m_callbacks.size());
+}
+
+void PathRequestManager::DeliverResults()
+{
+	// move this frame's share out first so callbacks can submit new requests without holding the lock.
+	// Results cancelled after a worker started on them are dropped here, so they neither pile up while
+	// nothing is pending nor use up the frame budget
+	m_delivering.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_resultMutex);
+		while (!m_results.empty() && static_cast<int>(m_delivering.size()) < m_frameBudget)
+		{
+			if (m_callbacks.find(m_results.front().ticket) != m_callbacks.end())
+			{
+				m_delivering.push_back(std::move(m_results.front()));
+			}
+			m_results.pop_front();
+		}
+	}
+
+	for (const auto& result : m_delivering)
+	{
+		const auto it = m_callbacks.find(result.ticket);
+		if (it == m_callbacks.end())
+		{
+			// cancelled by an earlier callback this frame
+			continue;
+		}
+
+		const auto callback = std::move(it->second);
+		m_callbacks.erase(it);
+		if (callback)
+		{
+			callback(result.ticket, result.found, result.path);
+		}
+	}
+}
+
+void PathRequestManager::SetFrameBudget(const int max_results)
+{
+	m_frameBudget = std::max(max_results, 1);
+}
+
+int PathRequestManager::GetFrameBudget() const
+{
+	return m_frameBudget;
+}
+
+void PathRequestManager::SetWorkerCount(const int count)
+{
+	m_workerCount = std::max(count, 1);
+}
+
+void PathRequestManager::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		m_running = false;
+		m_requests.clear();
+	}
+	m_requestCondition.notify_all();
+
+	for (auto& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_resultMutex);
+		m_results.clear();
+	}
+	m_callbacks.clear();
+	m_snapshot.reset();
+	m_snapshotVersion = 0;
+}
+
+void PathRequestManager::StartWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		m_running = true;
+	}
+
+	for (int i = 0; i < m_workerCount; ++i)
+	{
+		m_workers.emplace_back(&PathRequestManager::WorkerLoop, this);
+	}
+}
+
+void PathRequestManager::WorkerLoop()
+{
+	// each worker keeps its own search scratch
+	PathFinder path_finder;
+	path_finder.SetAllowDiagonals(true);
+
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(m_requestMutex);
+			m_requestCondition.wait(lock, [this] { return !m_running || !m_requests.empty(); });
+			if (!m_running)
+			{
+				return;
+			}
+			request = std::move(m_requests.front());
+			m_requests.pop_front();
+		}
+
+		Result result;
+		result.ticket = request.ticket;
+		result.found = path_finder.FindPath(*request.grid, request.start, request.goal, request.heuristic, result.path);
+
+		std::lock_guard<std::mutex> lock(m_resultMutex);
+		m_results.push_back(std::move(result));
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef __PATH_REQUEST_MANAGER__
+#define __PATH_REQUEST_MANAGER__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "Heuristic.h"
+#include "NavigationGrid.h"
+
+using PathTicket = uint32_t;
+using PathCallback = std::function<void(PathTicket ticket, bool found, const std::vector<glm::ivec2>& path)>;
+
+/* Singleton
+ * Resolves path requests on a pool of worker threads so a burst of agents asking for paths never stalls
+ * the frame. Requests are searched against an immutable copy of the navigation grid taken by
+ * SetNavigationGrid, so workers never see the grid change under them. Finished paths wait until
+ * DeliverResults hands them to their callbacks on the main thread, at most GetFrameBudget per frame.
+ */
+class PathRequestManager
+{
+public:
+	static PathRequestManager& Instance()
+	{
+		static PathRequestManager instance;
+		return instance;
+	}
+
+	static constexpr PathTicket INVALID_TICKET = 0;
+
+	/*
+	 * Takes a new snapshot for requests submitted from now on, only when the grid actually changed since
+	 * the last one. Requests already queued keep the snapshot they were submitted with
+	 */
+	void SetNavigationGrid(const NavigationGrid& grid);
+
+	// returns INVALID_TICKET when no grid has been set
+	PathTicket Submit(glm::ivec2 start, glm::ivec2 goal, Heuristic heuristic, PathCallback callback);
+	// the callback of a cancelled request is never called
+	void Cancel(PathTicket ticket);
+	[[nodiscard]] bool IsPending(PathTicket ticket) const;
+	[[nodiscard]] int GetPendingCount() const;
+
+	// called by the scene at the start of each update, runs the callbacks of finished requests
+	void DeliverResults();
+
+	// most callbacks DeliverResults runs in one frame, the rest wait for the next
+	void SetFrameBudget(int max_results);
+	[[nodiscard]] int GetFrameBudget() const;
+
+	// number of worker threads, takes effect the next time the workers start
+	void SetWorkerCount(int count);
+	// stops and joins the workers and drops every pending request
+	void Shutdown();
+
+private:
+	PathRequestManager();
+	~PathRequestManager();
+
+	struct Request
+	{
+		PathTicket ticket;
+		std::shared_ptr<const NavigationGrid> grid;
+		glm::ivec2 start;
+		glm::ivec2 goal;
+		Heuristic heuristic;
+	};
+
+	struct Result
+	{
+		PathTicket ticket;
+		bool found;
+		std::vector<glm::ivec2> path;
+	};
+
+	void StartWorkers();
+	void WorkerLoop();
+
+	// main thread only
+	std::shared_ptr<const NavigationGrid> m_snapshot;
+	// the version of the grid m_snapshot was copied from, unique to that grid and that edit
+	uint64_t m_snapshotVersion;
+	PathTicket m_nextTicket;
+	std::unordered_map<PathTicket, PathCallback> m_callbacks;
+	std::vector<Result> m_delivering;
+	int m_frameBudget;
+	int m_workerCount;
+
+	std::vector<std::thread> m_workers;
+	bool m_running;
+
+	std::mutex m_requestMutex;
+	std::condition_variable m_requestCondition;
+	std::deque<Request> m_requests;
+
+	std::mutex m_resultMutex;
+	std::deque<Result> m_results;
+};
+
+#endif /* defined (__PATH_REQUEST_MANAGER__) */
@@ -9,6 +9,7 @@ Plane::Plane()
 		"spritesheet");
 
 	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet("spritesheet"));
+	m_spriteSheetTexture = TextureManager::Instance().GetTextureHandle("spritesheet");
 
 	// set frame width
 	SetWidth(65);
@@ -31,8 +32,8 @@ Plane::~Plane()
 void Plane::Draw()
 {
 	// draw the plane sprite with simple propeller animation
-	TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("plane"),
-		GetTransform()->position, 0.5f, 0, 255, true);
+	TextureManager::Instance().PlayAnimation(m_spriteSheetTexture, GetAnimator(),
+		GetTransform()->position, 0, 255, true);
 }
 
 void Plane::Update()
@@ -45,12 +46,6 @@ void Plane::Clean()
 
 void Plane::BuildAnimations()
 {
-	auto plane_animation = Animation();
-
-	plane_animation.name = "plane";
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane1"));
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane2"));
-	plane_animation.frames.push_back(GetSpriteSheet()->GetFrame("plane3"));
-
-	SetAnimation(plane_animation);
+	m_planeAnimation = AnimationManager::Instance().CreateClip("plane", *GetSpriteSheet(), 20.0f);
+	SetAnimation(m_planeAnimation);
 }
\ No newline at end of file
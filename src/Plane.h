@@ -17,6 +17,9 @@ public:
 
 private:
 	void BuildAnimations();
+
+	TextureHandle m_spriteSheetTexture;
+	AnimationHandle m_planeAnimation;
 };
 
 #endif /* defined (__PLANE__) */
@@ -8,6 +8,9 @@
 #include "imgui_sdl.h"
 #include "Renderer.h"
 #include "Util.h"
+#include "PathFinder.h"
+#include "HierarchicalPathFinder.h"
+#include "SteeringSystem.h"
 
 PlayScene::PlayScene()
 {
@@ -185,6 +188,16 @@ void PlayScene::GetKeyboardInput()
 	}
 }
 
+AssetManifest PlayScene::GetManifest()
+{
+	AssetManifest manifest;
+	manifest.AddSpriteSheet("../Assets/sprites/atlas.txt", "../Assets/sprites/atlas.png", "spritesheet");
+	manifest.AddTexture("../Assets/textures/backButton.png", "backButton");
+	manifest.AddTexture("../Assets/textures/nextButton.png", "nextButton");
+	manifest.AddFont(Label::FontPath("Consolas"), Label::FontID("Consolas", 20), 20);
+	return manifest;
+}
+
 void PlayScene::Start()
 {
 	// Set GUI Title
@@ -277,6 +290,24 @@ void PlayScene::GUI_Function()
 
 	ImGui::Separator();
 
+	if (ImGui::Button("Run Pathfinding Benchmark"))
+	{
+		// 10x the Config grid in each direction, a quarter of the tiles blocked
+		PathFinder::RunBenchmark(Config::COL_NUM * 10, Config::ROW_NUM * 10, 0.25f, 1000, 1);
+	}
+
+	if (ImGui::Button("Run HPA* Benchmark"))
+	{
+		HierarchicalPathFinder::RunBenchmark(Config::COL_NUM * 10, Config::ROW_NUM * 10, 0.25f, 1000, 1);
+	}
+
+	if (ImGui::Button("Run Steering Benchmark"))
+	{
+		SteeringSystem::RunBenchmark(5000, 120, 1);
+	}
+
+	ImGui::Separator();
+
 	static float float3[3] = { 0.0f, 1.0f, 1.5f };
 	if(ImGui::SliderFloat3("My Slider", float3, 0.0f, 2.0f))
 	{
@@ -3,6 +3,7 @@
 #define __PLAY_SCENE__
 
 #include "Scene.h"
+#include "AssetManifest.h"
 #include "Plane.h"
 #include "Player.h"
 #include "Button.h"
@@ -20,6 +21,9 @@ public:
 	virtual void Clean() override;
 	virtual void HandleEvents() override;
 	virtual void Start() override;
+
+	// everything Start loads, so the scene can be loaded in the background before it is created
+	static AssetManifest GetManifest();
 private:
 	// IMGUI Function
 	void GUI_Function();
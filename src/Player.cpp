@@ -9,6 +9,7 @@ Player::Player(): m_currentAnimationState(PlayerAnimationState::PLAYER_IDLE_RIGH
 		"spritesheet");
 
 	SetSpriteSheet(TextureManager::Instance().GetSpriteSheet("spritesheet"));
+	m_spriteSheetTexture = TextureManager::Instance().GetTextureHandle("spritesheet");
 	
 	// set frame width
 	SetWidth(53);
@@ -30,28 +31,12 @@ Player::~Player()
 
 void Player::Draw()
 {
-	// draw the player according to animation state
-	switch(m_currentAnimationState)
-	{
-	case PlayerAnimationState::PLAYER_IDLE_RIGHT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("idle"),
-			GetTransform()->position, 0.12f, 0, 255, true);
-		break;
-	case PlayerAnimationState::PLAYER_IDLE_LEFT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("idle"),
-			GetTransform()->position, 0.12f, 0, 255, true, SDL_FLIP_HORIZONTAL);
-		break;
-	case PlayerAnimationState::PLAYER_RUN_RIGHT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("run"),
-			GetTransform()->position, 0.25f, 0, 255, true);
-		break;
-	case PlayerAnimationState::PLAYER_RUN_LEFT:
-		TextureManager::Instance().PlayAnimation("spritesheet", GetAnimation("run"),
-			GetTransform()->position, 0.25f, 0, 255, true, SDL_FLIP_HORIZONTAL);
-		break;
-	default:
-		break;
-	}
+	// the animation itself is picked by SetAnimationState, facing left only flips it
+	const auto flip = m_currentAnimationState == PlayerAnimationState::PLAYER_IDLE_LEFT ||
+		m_currentAnimationState == PlayerAnimationState::PLAYER_RUN_LEFT ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+
+	TextureManager::Instance().PlayAnimation(m_spriteSheetTexture, GetAnimator(),
+		GetTransform()->position, 0, 255, true, flip);
 }
 
 void Player::Update()
@@ -65,27 +50,28 @@ void Player::Clean()
 void Player::SetAnimationState(const PlayerAnimationState new_state)
 {
 	m_currentAnimationState = new_state;
+
+	switch (m_currentAnimationState)
+	{
+	case PlayerAnimationState::PLAYER_IDLE_RIGHT:
+	case PlayerAnimationState::PLAYER_IDLE_LEFT:
+		SetAnimation(m_idleAnimation);
+		break;
+	case PlayerAnimationState::PLAYER_RUN_RIGHT:
+	case PlayerAnimationState::PLAYER_RUN_LEFT:
+		SetAnimation(m_runAnimation);
+		break;
+	default:
+		break;
+	}
 }
 
 void Player::BuildAnimations()
 {
-	auto idle_animation = Animation();
-
-	idle_animation.name = "idle";
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-0"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-1"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-2"));
-	idle_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-idle-3"));
-
-	SetAnimation(idle_animation);
-
-	auto run_animation = Animation();
-
-	run_animation.name = "run";
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-0"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-1"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-2"));
-	run_animation.frames.push_back(GetSpriteSheet()->GetFrame("megaman-run-3"));
+	// the rates the frame counted animations used to run at, at 60 frames per second
+	auto& animation_manager = AnimationManager::Instance();
+	m_idleAnimation = animation_manager.CreateClip("megaman-idle", *GetSpriteSheet(), 3.5f);
+	m_runAnimation = animation_manager.CreateClip("megaman-run", *GetSpriteSheet(), 7.5f);
 
-	SetAnimation(run_animation);
+	SetAnimationState(m_currentAnimationState);
 }
@@ -23,6 +23,9 @@ private:
 	void BuildAnimations();
 
 	PlayerAnimationState m_currentAnimationState;
+	TextureHandle m_spriteSheetTexture;
+	AnimationHandle m_idleAnimation;
+	AnimationHandle m_runAnimation;
 };
 
 #endif /* defined (__PLAYER__) */
\ No newline at end of file
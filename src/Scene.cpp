@@ -2,10 +2,14 @@
 
 #include <algorithm>
 
+#include "ComponentStore.h"
 #include "DisplayObject.h"
+#include "Game.h"
+#include "PathRequestManager.h"
 
-Scene::Scene()
-= default;
+Scene::Scene() : m_worldBounds(ComponentStore::Bounds{ glm::vec2(0.0f, 0.0f), glm::vec2(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT) })
+{
+}
 
 Scene::~Scene()
 {
@@ -28,13 +32,76 @@ void Scene::AddChild(DisplayObject * child, uint32_t layer_index, std::optional<
 	}
 	child->SetLayerIndex(layer_index, index);
 	child->m_pParentScene = this;
+
+	// Children usually arrive in draw order, so only re-sort when this one belongs before the current last element
+	if (!m_displayList.empty() && SortObjects(child, m_displayList.back()))
+	{
+		m_displayListDirty = true;
+	}
 	m_displayList.push_back(child);
+
+	AddToTypeList(child);
 }
 
 void Scene::RemoveChild(DisplayObject * child)
 {
-	delete child;
-	m_displayList.erase(std::remove(m_displayList.begin(), m_displayList.end(), child), m_displayList.end());
+	if (child == nullptr || child->m_pendingRemoval)
+	{
+		return;
+	}
+
+	child->m_pendingRemoval = true;
+	m_pendingRemovals.push_back(child);
+	m_collisionWorld.Remove(child);
+	m_steeringSystem.Remove(child->GetEntity());
+
+	RemoveFromTypeList(child);
+}
+
+void Scene::AddToTypeList(DisplayObject* child)
+{
+	if (child->GetType() == GameObjectType::NONE)
+	{
+		return;
+	}
+
+	auto& children_of_type = m_childrenByType[static_cast<size_t>(child->GetType())];
+	child->m_typeListIndex = static_cast<int>(children_of_type.size());
+	children_of_type.push_back(child);
+}
+
+void Scene::RemoveFromTypeList(DisplayObject* child)
+{
+	if (child->m_typeListIndex < 0)
+	{
+		return;
+	}
+
+	// swap the last child of the same type into this slot
+	auto& children_of_type = m_childrenByType[static_cast<size_t>(child->GetType())];
+	DisplayObject* last_child = children_of_type.back();
+	children_of_type[child->m_typeListIndex] = last_child;
+	last_child->m_typeListIndex = child->m_typeListIndex;
+	children_of_type.pop_back();
+	child->m_typeListIndex = -1;
+}
+
+void Scene::FlushPendingRemovals()
+{
+	if (m_pendingRemovals.empty())
+	{
+		return;
+	}
+
+	// a single order-preserving pass, however many children were removed this frame
+	m_displayList.erase(std::remove_if(m_displayList.begin(), m_displayList.end(),
+		[](const DisplayObject* display_object) { return display_object->m_pendingRemoval; }), m_displayList.end());
+
+	for (const auto display_object : m_pendingRemovals)
+	{
+		delete display_object;
+	}
+	m_pendingRemovals.clear();
 }
 
 void Scene::RemoveAllChildren()
@@ -46,12 +113,19 @@ void Scene::RemoveAllChildren()
 	}
 
 	m_displayList.clear();
+	m_pendingRemovals.clear();
+	m_collisionWorld.Clear();
+	m_steeringSystem.Clear();
+	for (auto& children_of_type : m_childrenByType)
+	{
+		children_of_type.clear();
+	}
 }
 
 
 int Scene::NumberOfChildren() const
 {
-	return m_displayList.size();
+	return static_cast<int>(m_displayList.size() - m_pendingRemovals.size());
 }
 
 bool Scene::SortObjects(DisplayObject * left, DisplayObject * right)
@@ -72,28 +146,54 @@ bool Scene::SortObjects(DisplayObject * left, DisplayObject * right)
 		left->IsEnabled();
 }
 
+void Scene::SortDisplayList()
+{
+	if (!m_displayListDirty)
+	{
+		return;
+	}
+
+	// stable so children that compare equal keep their current relative order between sorts
+	std::stable_sort(m_displayList.begin(), m_displayList.end(), SortObjects);
+	m_displayListDirty = false;
+}
+
 void Scene::UpdateDisplayList()
 {
-	std::sort(m_displayList.begin(), m_displayList.end(), SortObjects);
-	for (auto& display_object : m_displayList)
+	// paths finished on the worker threads reach their agents before anything updates
+	PathRequestManager::Instance().DeliverResults();
+
+	SortDisplayList();
+	// index based, children added during an Update can grow the list
+	for (size_t i = 0; i < m_displayList.size(); ++i)
 	{
-		if (display_object != nullptr)
+		DisplayObject* display_object = m_displayList[i];
+		if (display_object != nullptr && !display_object->m_pendingRemoval)
 		{
 			if (!display_object->IsEnabled())
 				break;
 			display_object->Update();
 		}
 	}
+
+	// steering, then batched integrate, bounds and collision prep for every simulated object
+	const float delta_time = Game::Instance().GetDeltaTime() > 0.0f ? Game::Instance().GetDeltaTime() : 1.0f / 60.0f;
+	m_steeringSystem.Update(delta_time);
+	ComponentStore::Instance().Update(delta_time, m_worldBounds);
+
+	m_collisionWorld.Update();
+
+	FlushPendingRemovals();
 }
 
 void Scene::DrawDisplayList()
 {
-	std::sort(m_displayList.begin(), m_displayList.end(), SortObjects);
+	SortDisplayList();
 	for (auto& display_object : m_displayList)
 	{
 		if (display_object != nullptr)
 		{
-			if (display_object->IsEnabled() && display_object->IsVisible())
+			if (display_object->IsEnabled() && display_object->IsVisible() && !display_object->m_pendingRemoval)
 			{
 				display_object->Draw();
 			}
@@ -103,7 +203,42 @@ void Scene::DrawDisplayList()
 
 }
 
-std::vector<DisplayObject*> Scene::GetDisplayList() const
+const std::vector<DisplayObject*>& Scene::GetDisplayList() const
 {
 	return m_displayList;
 }
+
+CollisionWorld& Scene::GetCollisionWorld()
+{
+	return m_collisionWorld;
+}
+
+SteeringSystem& Scene::GetSteeringSystem()
+{
+	return m_steeringSystem;
+}
+
+void Scene::SetWorldBounds(const glm::vec2 world_min, const glm::vec2 world_max)
+{
+	m_worldBounds = ComponentStore::Bounds{ world_min, world_max };
+}
+
+void Scene::ClearWorldBounds()
+{
+	m_worldBounds.reset();
+}
+
+const std::optional<ComponentStore::Bounds>& Scene::GetWorldBounds() const
+{
+	return m_worldBounds;
+}
+
+const std::vector<DisplayObject*>& Scene::GetChildrenOfType(const GameObjectType type) const
+{
+	static const std::vector<DisplayObject*> no_children;
+	if (type == GameObjectType::NONE || type == GameObjectType::NUM_OF_TYPES)
+	{
+		return no_children;
+	}
+	return m_childrenByType[static_cast<size_t>(type)];
+}
@@ -2,9 +2,13 @@
 #ifndef __SCENE__
 #define __SCENE__
 
+#include <array>
 #include <vector>
 #include <optional>
 #include "GameObject.h"
+#include "CollisionWorld.h"
+#include "ComponentStore.h"
+#include "SteeringSystem.h"
 
 
 class Scene : public GameObject
@@ -22,6 +26,10 @@ public:
 	virtual void Start() = 0;
 
 	void AddChild(DisplayObject* child, uint32_t layer_index = 0, std::optional<uint32_t> order_index = std::nullopt);
+	/*
+	 * Queues the child for destruction. It stops updating and drawing straight away and is deleted
+	 * once the current UpdateDisplayList finishes, so it is safe to call from inside a child's Update
+	 */
 	void RemoveChild(DisplayObject* child);
 
 	void RemoveAllChildren();
@@ -30,13 +38,58 @@ public:
 	void UpdateDisplayList();
 	void DrawDisplayList();
 
-	[[nodiscard]] std::vector<DisplayObject*> GetDisplayList() const;
+	/*
+	 * View of the children in draw order, valid until the next AddChild or UpdateDisplayList.
+	 * Children queued by RemoveChild stay in the list until the end of the frame, check IsPendingRemoval
+	 */
+	[[nodiscard]] const std::vector<DisplayObject*>& GetDisplayList() const;
+	/*
+	 * All children of the given type in no particular order, kept up to date by AddChild, RemoveChild and SetType
+	 */
+	[[nodiscard]] const std::vector<DisplayObject*>& GetChildrenOfType(GameObjectType type) const;
+
+	/*
+	 * Broadphase for this scene's colliding children. Register them with GetCollisionWorld().Add,
+	 * RemoveChild unregisters them, and the contact events are refreshed by every UpdateDisplayList
+	 */
+	[[nodiscard]] CollisionWorld& GetCollisionWorld();
+
+	/*
+	 * Steering for this scene's agents. Register them with GetSteeringSystem().Add and make them simulated,
+	 * RemoveChild unregisters them, and their velocities are steered by every UpdateDisplayList
+	 */
+	[[nodiscard]] SteeringSystem& GetSteeringSystem();
+
+	/*
+	 * Rectangle every UpdateDisplayList keeps this scene's simulated children inside, the screen by default.
+	 * Scenes with a world larger than the screen set their own, ClearWorldBounds leaves them unconstrained
+	 */
+	void SetWorldBounds(glm::vec2 world_min, glm::vec2 world_max);
+	void ClearWorldBounds();
+	[[nodiscard]] const std::optional<ComponentStore::Bounds>& GetWorldBounds() const;
 
 private:
 	uint32_t m_nextLayerIndex = 0;
 	std::vector<DisplayObject*> m_displayList;
 
+	// children indexed by type, each child remembers its slot so it can be swapped out in O(1)
+	std::array<std::vector<DisplayObject*>, static_cast<size_t>(GameObjectType::NUM_OF_TYPES)> m_childrenByType;
+	std::vector<DisplayObject*> m_pendingRemovals;
+
+	CollisionWorld m_collisionWorld;
+	SteeringSystem m_steeringSystem;
+	std::optional<ComponentStore::Bounds> m_worldBounds;
+
+	void FlushPendingRemovals();
+	// keep m_childrenByType and the child's m_typeListIndex in step, also used when a child changes type
+	void AddToTypeList(DisplayObject* child);
+	void RemoveFromTypeList(DisplayObject* child);
+
+	// Set whenever a child's layer, order or enabled state changes; the list is only re-sorted while this is set
+	bool m_displayListDirty = false;
+
 	static bool SortObjects(DisplayObject* left, DisplayObject* right);
+	void SortDisplayList();
 };
 
 #endif /* defined (__SCENE__) */
@@ -0,0 +1,125 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <climits>
+
+SkylinePacker::SkylinePacker(const int width, const int height, const int padding)
+	: m_width(width), m_height(height), m_padding(padding), m_usedArea(0)
+{
+	m_skyline.push_back({ 0, 0, width });
+}
+
+bool SkylinePacker::Insert(const int width, const int height, SDL_Rect& placed)
+{
+	if (width <= 0 || height <= 0)
+	{
+		return false;
+	}
+
+	const auto padded_height = height + m_padding;
+
+	size_t best_index = m_skyline.size();
+	auto best_top = INT_MAX;
+	auto best_width = INT_MAX;
+	for (size_t i = 0; i < m_skyline.size(); ++i)
+	{
+		const auto y = FitAt(i, width, height);
+		if (y < 0)
+		{
+			continue;
+		}
+
+		// lowest top first, then the narrowest gap so wide gaps are kept for wide rectangles
+		const auto top = y + padded_height;
+		if (top < best_top || (top == best_top && m_skyline[i].width < best_width))
+		{
+			best_index = i;
+			best_top = top;
+			best_width = m_skyline[i].width;
+		}
+	}
+
+	if (best_index == m_skyline.size())
+	{
+		return false;
+	}
+
+	// the padding only has to fit between rectangles, not past the page's own edge
+	const auto x = m_skyline[best_index].x;
+	const SkylineNode node{ x, best_top, std::min(width + m_padding, m_width - x) };
+	placed = { x, best_top - padded_height, width, height };
+
+	// the new node covers the nodes under it, the one it ends inside is trimmed
+	m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(best_index), node);
+	for (auto i = best_index + 1; i < m_skyline.size();)
+	{
+		auto& next = m_skyline[i];
+		const auto covered = node.x + node.width - next.x;
+		if (covered <= 0)
+		{
+			break;
+		}
+		if (covered < next.width)
+		{
+			next.x += covered;
+			next.width -= covered;
+			break;
+		}
+		m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+	}
+
+	// neighbours at the same height become one node
+	for (size_t i = 0; i + 1 < m_skyline.size();)
+	{
+		if (m_skyline[i].y == m_skyline[i + 1].y)
+		{
+			m_skyline[i].width += m_skyline[i + 1].width;
+			m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	m_usedArea += static_cast<long long>(width) * height;
+	return true;
+}
+
+int SkylinePacker::GetWidth() const
+{
+	return m_width;
+}
+
+int SkylinePacker::GetHeight() const
+{
+	return m_height;
+}
+
+float SkylinePacker::GetOccupancy() const
+{
+	return static_cast<float>(static_cast<double>(m_usedArea) / (static_cast<double>(m_width) * m_height));
+}
+
+int SkylinePacker::FitAt(const size_t index, const int width, const int height) const
+{
+	const auto x = m_skyline[index].x;
+	if (x + width > m_width)
+	{
+		return -1;
+	}
+
+	// the rectangle rests on the highest node it spans
+	auto y = 0;
+	auto remaining = std::min(width + m_padding, m_width - x);
+	for (auto i = index; remaining > 0; ++i)
+	{
+		y = std::max(y, m_skyline[i].y);
+		if (y + height > m_height)
+		{
+			return -1;
+		}
+		remaining -= m_skyline[i].width;
+	}
+	return y;
+}
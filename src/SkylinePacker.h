@@ -0,0 +1,46 @@
+#pragma once
+#ifndef __SKYLINE_PACKER__
+#define __SKYLINE_PACKER__
+
+#include <vector>
+
+#include <SDL.h>
+
+/*
+ * Places rectangles on a fixed size page, bottom-left first. The page is tracked as its skyline, the top
+ * edge of everything placed so far, and each rectangle goes where its top ends up lowest. Rectangles that
+ * arrive sorted tallest first waste the least space
+ */
+class SkylinePacker
+{
+public:
+	// padding is the gap kept to the right of and below every rectangle
+	SkylinePacker(int width, int height, int padding);
+
+	// false when the rectangle no longer fits anywhere on the page
+	bool Insert(int width, int height, SDL_Rect& placed);
+
+	[[nodiscard]] int GetWidth() const;
+	[[nodiscard]] int GetHeight() const;
+	// fraction of the page covered by what was placed, padding not counted
+	[[nodiscard]] float GetOccupancy() const;
+
+private:
+	struct SkylineNode
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	// the y the rectangle would sit at if its left edge went on node index, -1 if it doesn't fit there
+	[[nodiscard]] int FitAt(size_t index, int width, int height) const;
+
+	int m_width;
+	int m_height;
+	int m_padding;
+	long long m_usedArea;
+	std::vector<SkylineNode> m_skyline;
+};
+
+#endif /* defined (__SKYLINE_PACKER__) */
@@ -10,6 +10,16 @@ SoundManager::SoundManager()
 SoundManager::~SoundManager()
 = default;
 
+SoundHandle SoundManager::GetSoundHandle(const AssetName id)
+{
+	return m_sfxs.Intern(id);
+}
+
+MusicHandle SoundManager::GetMusicHandle(const AssetName id)
+{
+	return m_music.Intern(id);
+}
+
 void SoundManager::AllocateChannels(const int channels) const
 {
 	Mix_AllocateChannels(channels);
@@ -25,7 +35,12 @@ bool SoundManager::Load(const std::string & file_name, const std::string & id, c
 			std::cout << "Could not load music: ERROR - " << Mix_GetError() << std::endl;
 			return false;
 		}
-		m_music[id] = music;
+		const auto handle = m_music.Intern(id);
+		if (m_music.IsLoaded(handle))
+		{
+			Mix_FreeMusic(m_music.Get(handle));
+		}
+		m_music.Set(handle, music);
 		return true;
 	}
 	else if (type == SoundType::SOUND_SFX)
@@ -36,7 +51,12 @@ bool SoundManager::Load(const std::string & file_name, const std::string & id, c
 			std::cout << "Could not load SFX: ERROR - " << Mix_GetError() << std::endl;
 			return false;
 		}
-		m_sfxs[id] = chunk;
+		const auto handle = m_sfxs.Intern(id);
+		if (m_sfxs.IsLoaded(handle))
+		{
+			Mix_FreeChunk(m_sfxs.Get(handle));
+		}
+		m_sfxs.Set(handle, chunk);
 		return true;
 	}
 	return false;
@@ -44,15 +64,17 @@ bool SoundManager::Load(const std::string & file_name, const std::string & id, c
 
 void SoundManager::Unload(const std::string & id, const SoundType type)
 {
-	if (type == SoundType::SOUND_MUSIC && m_music.find(id) != m_music.end())
+	const auto music = m_music.Find(id);
+	const auto sfx = m_sfxs.Find(id);
+	if (type == SoundType::SOUND_MUSIC && m_music.IsLoaded(music))
 	{
-		Mix_FreeMusic(m_music[id]);
-		m_music.erase(id);
+		Mix_FreeMusic(m_music.Get(music));
+		m_music.Reset(music);
 	}
-	else if (type == SoundType::SOUND_SFX && m_sfxs.find(id) != m_sfxs.end())
+	else if (type == SoundType::SOUND_SFX && m_sfxs.IsLoaded(sfx))
 	{
-		Mix_FreeChunk(m_sfxs[id]);
-		m_sfxs.erase(id);
+		Mix_FreeChunk(m_sfxs.Get(sfx));
+		m_sfxs.Reset(sfx);
 	}
 	else
 	{
@@ -61,9 +83,19 @@ void SoundManager::Unload(const std::string & id, const SoundType type)
 }
 
 void SoundManager::PlayMusic(const std::string & id, const int loop/* = -1 */, const int fade_in/* = 0 */)
+{
+	PlayMusic(m_music.Find(id), loop, fade_in);
+}
+
+void SoundManager::PlayMusic(const MusicHandle handle, const int loop/* = -1 */, const int fade_in/* = 0 */)
 {
 	std::cout << "Playing music..." << fade_in << std::endl;
-	if (Mix_FadeInMusic(m_music[id], loop, fade_in) == -1)
+	if (!m_music.IsLoaded(handle))
+	{
+		std::cout << "Unable to play music: not loaded" << std::endl;
+		return;
+	}
+	if (Mix_FadeInMusic(m_music.Get(handle), loop, fade_in) == -1)
 	{
 		std::cout << "Unable to play music: ERROR - " << Mix_GetError() << std::endl;
 	}
@@ -95,7 +127,17 @@ void SoundManager::ResumeMusic() const
 
 void SoundManager::PlaySound(const std::string & id, const int loop/* = 0 */, const int channel/* = -1 */)
 {
-	if (Mix_PlayChannel(channel, m_sfxs[id], loop) == -1)
+	PlaySound(m_sfxs.Find(id), loop, channel);
+}
+
+void SoundManager::PlaySound(const SoundHandle handle, const int loop/* = 0 */, const int channel/* = -1 */)
+{
+	if (!m_sfxs.IsLoaded(handle))
+	{
+		std::cout << "Unable to play SFX: not loaded" << std::endl;
+		return;
+	}
+	if (Mix_PlayChannel(channel, m_sfxs.Get(handle), loop) == -1)
 	{
 		std::cout << "Unable to play SFX: ERROR - " << Mix_GetError() << std::endl;
 	}
@@ -158,11 +200,14 @@ void SoundManager::Quit()
 		Mix_HaltChannel(-1); // Halt all channels.
 	}
 
-	for (const auto& [fst, snd] : m_sfxs)
+	for (uint32_t index = 0; index < m_sfxs.GetSlotCount(); ++index)
 	{
-		Mix_FreeChunk(m_sfxs[fst]);
+		if (m_sfxs.IsLoaded(SoundHandle{ index }))
+		{
+			Mix_FreeChunk(m_sfxs.Get(SoundHandle{ index }));
+		}
 	}
-	m_sfxs.clear();
+	m_sfxs.ResetAll();
 
 	// Clean up music.
 	if (Mix_PlayingMusic())
@@ -170,11 +215,14 @@ void SoundManager::Quit()
 		Mix_HaltMusic();
 	}
 
-	for (const auto& [fst, snd] : m_music)
+	for (uint32_t index = 0; index < m_music.GetSlotCount(); ++index)
 	{
-		Mix_FreeMusic(m_music[fst]);
+		if (m_music.IsLoaded(MusicHandle{ index }))
+		{
+			Mix_FreeMusic(m_music.Get(MusicHandle{ index }));
+		}
 	}
-	m_music.clear();
+	m_music.ResetAll();
 
 	// Quit.
 	Mix_CloseAudio();
@@ -5,8 +5,8 @@
 // Core Libraries
 #include <iostream>
 #include <string>
-#include <map> 
 
+#include "AssetRegistry.h"
 #include "SoundType.h"
 #include <SDL_mixer.h>
 
@@ -20,14 +20,20 @@ public:
 		return instance;
 	}
 
+	// handles stay valid across Load and Unload, look them up once and keep them
+	SoundHandle GetSoundHandle(AssetName id);
+	MusicHandle GetMusicHandle(AssetName id);
+
 	void AllocateChannels(const int channels) const;
 	bool Load(const std::string& file_name, const std::string& id, SoundType type);
 	void Unload(const std::string& id, SoundType type);
 	void PlayMusic(const std::string& id, int loop = -1, int fade_in = 0);
+	void PlayMusic(MusicHandle handle, int loop = -1, int fade_in = 0);
 	void StopMusic(int fade_out = 0) const;
 	void PauseMusic() const;
 	void ResumeMusic() const;
 	void PlaySound(const std::string& id, int loop = 0, int channel = -1);
+	void PlaySound(SoundHandle handle, int loop = 0, int channel = -1);
 	void SetMusicVolume(const int vol) const;
 	void SetSoundVolume(const int vol) const;
 	void SetAllVolume(const int vol) const;
@@ -46,8 +52,8 @@ private: // Methods.
 
 private: // Properties.
 	static SoundManager* s_pInstance;
-	std::map<std::string, Mix_Chunk*> m_sfxs;
-	std::map<std::string, Mix_Music*> m_music;
+	AssetRegistry<SoundTag, Mix_Chunk*> m_sfxs;
+	AssetRegistry<MusicTag, Mix_Music*> m_music;
 	int m_pan{}; // A slider value from 0 to 100. 0 = full left, 100 = full right.
 };
 
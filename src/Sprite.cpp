@@ -1,20 +1,22 @@
 #include "Sprite.h"
 
-Sprite::Sprite()
+Sprite::Sprite() : m_pSpriteSheet(nullptr), m_animator(AnimationManager::Instance().CreateAnimator())
 {
 }
 
 Sprite::~Sprite()
-= default;
+{
+	AnimationManager::Instance().DestroyAnimator(m_animator);
+}
 
 SpriteSheet* Sprite::GetSpriteSheet()
 {
 	return m_pSpriteSheet;
 }
 
-Animation& Sprite::GetAnimation(const std::string& name)
+AnimatorHandle Sprite::GetAnimator() const
 {
-	return m_pAnimations[name];
+	return m_animator;
 }
 
 void Sprite::SetSpriteSheet(SpriteSheet* sprite_sheet)
@@ -22,15 +24,7 @@ void Sprite::SetSpriteSheet(SpriteSheet* sprite_sheet)
 	m_pSpriteSheet = sprite_sheet;
 }
 
-void Sprite::SetAnimation(const Animation& animation)
+void Sprite::SetAnimation(const AnimationHandle clip, const float speed)
 {
-	if(!CheckIfAnimationExists(animation.name))
-	{
-		m_pAnimations[animation.name] = animation;
-	}
+	AnimationManager::Instance().Play(m_animator, clip, speed);
 }
-
-bool Sprite::CheckIfAnimationExists(const std::string& id)
-{
-	return m_pAnimations.find(id) != m_pAnimations.end();
-}
\ No newline at end of file
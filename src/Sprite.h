@@ -3,8 +3,7 @@
 #define __SPRITE__
 
 #include "DisplayObject.h"
-#include "Animation.h"
-#include <unordered_map>
+#include "AnimationManager.h"
 #include "SpriteSheet.h"
 
 class Sprite : public DisplayObject
@@ -12,6 +11,10 @@ class Sprite : public DisplayObject
 public:
 	Sprite();
 	virtual ~Sprite();
+
+	// a copy would destroy the same animator twice
+	Sprite(const Sprite&) = delete;
+	Sprite& operator=(const Sprite&) = delete;
 	
 	// Life Cycle Functions
 	virtual void Draw() = 0;
@@ -20,18 +23,17 @@ public:
 
 	// getters
 	SpriteSheet* GetSpriteSheet();
-	Animation& GetAnimation(const std::string& name);
+	// this sprite's playback state in the AnimationManager, draw it with TextureManager::PlayAnimation
+	[[nodiscard]] AnimatorHandle GetAnimator() const;
 	
 	// setters
 	void SetSpriteSheet(SpriteSheet* sprite_sheet);
-	void SetAnimation(const Animation& animation);
+	// the clip keeps its place if it is already playing, speed scales its frame rate
+	void SetAnimation(AnimationHandle clip, float speed = 1.0f);
 private:
-	// private utility functions
-	bool CheckIfAnimationExists(const std::string& id);
-
 	SpriteSheet* m_pSpriteSheet;
 
-	std::unordered_map<std::string, Animation> m_pAnimations;
+	AnimatorHandle m_animator;
 };
 
 #endif /* defined (__SPRITE__) */
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "SpriteAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "MappedFile.h"
+
+namespace
+{
+	constexpr uint32_t Align(const uint32_t offset)
+	{
+		return (offset + 3u) & ~3u;
+	}
+
+	bool ReadBinaryFile(const std::string& file_name, std::vector<char>& data)
+	{
+		std::ifstream file(file_name, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+
+		const auto size = file.tellg();
+		if (size <= 0)
+		{
+			return false;
+		}
+
+		data.resize(static_cast<size_t>(size));
+		file.seekg(0);
+		file.read(data.data(), size);
+		return static_cast<bool>(file);
+	}
+
+	std::shared_ptr<MappedFile> MapFile(const std::string& file_name)
+	{
+		auto mapped_file = std::make_shared<MappedFile>();
+		if (!mapped_file->Open(file_name))
+		{
+			return nullptr;
+		}
+		return mapped_file;
+	}
+}
+
+SpriteAtlas::SpriteAtlas(std::shared_ptr<const void> storage, const char* data, const size_t size)
+	: m_storage(std::move(storage)), m_data(data), m_size(size)
+{
+	m_header = reinterpret_cast<const Header*>(m_data);
+	m_frames = reinterpret_cast<const PackedFrame*>(m_data + m_header->framesOffset);
+	m_animations = reinterpret_cast<const PackedAnimation*>(m_data + m_header->animationsOffset);
+}
+
+std::shared_ptr<const SpriteAtlas> SpriteAtlas::Load(const std::string& file_name)
+{
+	if (auto mapped_file = MapFile(file_name); mapped_file != nullptr && IsValid(mapped_file->GetData(), mapped_file->GetSize()))
+	{
+		const auto data = mapped_file->GetData();
+		const auto size = mapped_file->GetSize();
+		return std::shared_ptr<const SpriteAtlas>(new SpriteAtlas(std::move(mapped_file), data, size));
+	}
+
+	// a text atlas the converter has packed sits next to it, atlas.txt becomes atlas.atlas
+	const auto extension = file_name.find_last_of('.');
+	const auto slash = file_name.find_last_of("/\\");
+	const auto stem = extension != std::string::npos && (slash == std::string::npos || extension > slash) ? file_name.substr(0, extension) : file_name;
+	if (const auto packed_file_name = stem + FILE_EXTENSION; packed_file_name != file_name)
+	{
+		if (auto mapped_file = MapFile(packed_file_name); mapped_file != nullptr && IsValid(mapped_file->GetData(), mapped_file->GetSize()))
+		{
+			const auto data = mapped_file->GetData();
+			const auto size = mapped_file->GetSize();
+			return std::shared_ptr<const SpriteAtlas>(new SpriteAtlas(std::move(mapped_file), data, size));
+		}
+	}
+
+	// not converted yet, the text is packed in memory so lookups work the same way
+	std::vector<Frame> frames;
+	if (!ReadText(file_name, frames))
+	{
+		return nullptr;
+	}
+
+	auto packed = std::make_shared<std::vector<char>>(Pack(std::move(frames), "", {}));
+	const auto data = packed->data();
+	const auto size = packed->size();
+	return std::shared_ptr<const SpriteAtlas>(new SpriteAtlas(std::move(packed), data, size));
+}
+
+bool SpriteAtlas::ReadText(const std::string& file_name, std::vector<Frame>& frames)
+{
+	std::ifstream data_file(file_name, std::ios::in);
+	if (!data_file)
+	{
+		return false;
+	}
+
+	std::string input_line;
+	while (std::getline(data_file, input_line))
+	{
+		std::istringstream line(input_line);
+		Frame frame;
+		if (line >> frame.name >> frame.x >> frame.y >> frame.w >> frame.h)
+		{
+			frames.push_back(std::move(frame));
+		}
+	}
+
+	return true;
+}
+
+std::vector<char> SpriteAtlas::Pack(std::vector<Frame> frames, const std::string& texture_file_name, const std::vector<char>& embedded_image)
+{
+	struct SortedFrame
+	{
+		const Frame* frame;
+		uint32_t animationNameLength;
+		int32_t number;
+	};
+
+	std::vector<SortedFrame> sorted_frames;
+	sorted_frames.reserve(frames.size());
+	for (const auto& frame : frames)
+	{
+		SortedFrame sorted_frame{ &frame, 0, -1 };
+		SplitFrameName(frame.name, sorted_frame.animationNameLength, sorted_frame.number);
+		sorted_frames.push_back(sorted_frame);
+	}
+
+	// "run-10" comes after "run-9", not between "run-1" and "run-2"
+	std::sort(sorted_frames.begin(), sorted_frames.end(), [](const SortedFrame& lhs, const SortedFrame& rhs)
+	{
+		const std::string_view lhs_name(lhs.frame->name);
+		const std::string_view rhs_name(rhs.frame->name);
+		return std::make_tuple(lhs_name.substr(0, lhs.animationNameLength), lhs.number, lhs_name) <
+			std::make_tuple(rhs_name.substr(0, rhs.animationNameLength), rhs.number, rhs_name);
+	});
+
+	Header header{};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.frameCount = static_cast<uint32_t>(sorted_frames.size());
+
+	std::vector<PackedFrame> packed_frames;
+	std::vector<PackedAnimation> packed_animations;
+	std::string strings;
+	for (const auto& sorted_frame : sorted_frames)
+	{
+		const auto& frame = *sorted_frame.frame;
+		const auto name_offset = static_cast<uint32_t>(strings.size());
+		strings += frame.name;
+		packed_frames.push_back({ name_offset, static_cast<uint32_t>(frame.name.size()), sorted_frame.animationNameLength,
+			sorted_frame.number, frame.x, frame.y, frame.w, frame.h });
+
+		// a frame starts a new animation unless it shares the previous frame's animation name
+		const auto frame_index = static_cast<uint32_t>(packed_frames.size() - 1);
+		const std::string_view animation_name(frame.name.data(), sorted_frame.animationNameLength);
+		if (!packed_animations.empty())
+		{
+			const auto& previous = packed_animations.back();
+			if (std::string_view(strings.data() + previous.nameOffset, previous.nameLength) == animation_name)
+			{
+				++packed_animations.back().frameCount;
+				continue;
+			}
+		}
+		packed_animations.push_back({ name_offset, sorted_frame.animationNameLength, frame_index, 1 });
+	}
+	header.animationCount = static_cast<uint32_t>(packed_animations.size());
+
+	header.textureNameOffset = static_cast<uint32_t>(strings.size());
+	header.textureNameLength = static_cast<uint32_t>(texture_file_name.size());
+	strings += texture_file_name;
+
+	header.framesOffset = sizeof(Header);
+	header.animationsOffset = header.framesOffset + header.frameCount * static_cast<uint32_t>(sizeof(PackedFrame));
+	header.stringsOffset = header.animationsOffset + header.animationCount * static_cast<uint32_t>(sizeof(PackedAnimation));
+	header.stringsSize = static_cast<uint32_t>(strings.size());
+	header.imageOffset = embedded_image.empty() ? 0 : Align(header.stringsOffset + header.stringsSize);
+	header.imageSize = static_cast<uint32_t>(embedded_image.size());
+
+	std::vector<char> packed(embedded_image.empty() ? header.stringsOffset + header.stringsSize : header.imageOffset + header.imageSize);
+	std::memcpy(packed.data(), &header, sizeof(Header));
+	if (!packed_frames.empty())
+	{
+		std::memcpy(packed.data() + header.framesOffset, packed_frames.data(), packed_frames.size() * sizeof(PackedFrame));
+	}
+	if (!packed_animations.empty())
+	{
+		std::memcpy(packed.data() + header.animationsOffset, packed_animations.data(), packed_animations.size() * sizeof(PackedAnimation));
+	}
+	std::copy(strings.begin(), strings.end(), packed.begin() + header.stringsOffset);
+	std::copy(embedded_image.begin(), embedded_image.end(), packed.begin() + header.imageOffset);
+
+	return packed;
+}
+
+bool SpriteAtlas::PackFile(const std::string& text_file_name, const std::string& texture_file_name, const std::string& output_file_name, const bool embed_image)
+{
+	std::vector<Frame> frames;
+	if (!ReadText(text_file_name, frames))
+	{
+		std::cout << "error opening file " << text_file_name << std::endl;
+		return false;
+	}
+
+	std::vector<char> image;
+	if (embed_image && !ReadBinaryFile(texture_file_name, image))
+	{
+		std::cout << "error opening file " << texture_file_name << std::endl;
+		return false;
+	}
+
+	const auto frame_count = frames.size();
+	const auto packed = Pack(std::move(frames), embed_image ? "" : texture_file_name, image);
+
+	std::ofstream output_file(output_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!output_file.write(packed.data(), static_cast<std::streamsize>(packed.size())))
+	{
+		std::cout << "error writing file " << output_file_name << std::endl;
+		return false;
+	}
+
+	std::cout << "packed " << frame_count << " frames into " << output_file_name << " (" << packed.size() << " bytes)" << std::endl;
+	return true;
+}
+
+int SpriteAtlas::GetFrameCount() const
+{
+	return static_cast<int>(m_header->frameCount);
+}
+
+Frame SpriteAtlas::GetFrame(const int index) const
+{
+	if (index < 0 || index >= GetFrameCount())
+	{
+		return Frame{};
+	}
+
+	const auto& frame = m_frames[index];
+	return { std::string(GetString(frame.nameOffset, frame.nameLength)), frame.x, frame.y, frame.w, frame.h };
+}
+
+int SpriteAtlas::FindFrame(const std::string_view name) const
+{
+	uint32_t animation_name_length;
+	int32_t number;
+	SplitFrameName(name, animation_name_length, number);
+	const auto key = std::make_pair(name.substr(0, animation_name_length), number);
+
+	const auto frame_key = [this](const PackedFrame& frame)
+	{
+		return std::make_pair(GetString(frame.nameOffset, frame.animationNameLength), frame.number);
+	};
+
+	const auto end = m_frames + m_header->frameCount;
+	auto it = std::lower_bound(m_frames, end, key, [&frame_key](const PackedFrame& frame, const std::pair<std::string_view, int32_t>& value)
+	{
+		return frame_key(frame) < value;
+	});
+
+	// "run-1" and "run-01" share a key, so the name itself decides
+	for (; it != end && frame_key(*it) == key; ++it)
+	{
+		if (GetString(it->nameOffset, it->nameLength) == name)
+		{
+			return static_cast<int>(it - m_frames);
+		}
+	}
+	return -1;
+}
+
+int SpriteAtlas::GetAnimationCount() const
+{
+	return static_cast<int>(m_header->animationCount);
+}
+
+bool SpriteAtlas::FindAnimation(const std::string_view name, int& first_frame, int& frame_count) const
+{
+	const auto end = m_animations + m_header->animationCount;
+	const auto it = std::lower_bound(m_animations, end, name, [this](const PackedAnimation& animation, const std::string_view value)
+	{
+		return GetString(animation.nameOffset, animation.nameLength) < value;
+	});
+
+	if (it == end || GetString(it->nameOffset, it->nameLength) != name ||
+		static_cast<uint64_t>(it->firstFrame) + it->frameCount > m_header->frameCount)
+	{
+		return false;
+	}
+
+	first_frame = static_cast<int>(it->firstFrame);
+	frame_count = static_cast<int>(it->frameCount);
+	return true;
+}
+
+std::string_view SpriteAtlas::GetTextureFileName() const
+{
+	return GetString(m_header->textureNameOffset, m_header->textureNameLength);
+}
+
+bool SpriteAtlas::HasEmbeddedImage() const
+{
+	return m_header->imageSize > 0;
+}
+
+const char* SpriteAtlas::GetEmbeddedImage() const
+{
+	return HasEmbeddedImage() ? m_data + m_header->imageOffset : nullptr;
+}
+
+size_t SpriteAtlas::GetEmbeddedImageSize() const
+{
+	return m_header->imageSize;
+}
+
+bool SpriteAtlas::IsValid(const char* data, const size_t size)
+{
+	if (size < sizeof(Header))
+	{
+		return false;
+	}
+
+	Header header{};
+	std::memcpy(&header, data, sizeof(Header));
+	if (header.magic != MAGIC || header.version != VERSION)
+	{
+		return false;
+	}
+
+	const auto fits = [size](const uint64_t offset, const uint64_t length) { return offset + length <= size; };
+	return header.framesOffset % alignof(PackedFrame) == 0 &&
+		header.animationsOffset % alignof(PackedAnimation) == 0 &&
+		fits(header.framesOffset, static_cast<uint64_t>(header.frameCount) * sizeof(PackedFrame)) &&
+		fits(header.animationsOffset, static_cast<uint64_t>(header.animationCount) * sizeof(PackedAnimation)) &&
+		fits(header.stringsOffset, header.stringsSize) &&
+		fits(header.imageOffset, header.imageSize);
+}
+
+void SpriteAtlas::SplitFrameName(const std::string_view name, uint32_t& animation_name_length, int32_t& number)
+{
+	auto length = name.size();
+	while (length > 0 && name[length - 1] >= '0' && name[length - 1] <= '9')
+	{
+		--length;
+	}
+
+	if (length == name.size())
+	{
+		animation_name_length = static_cast<uint32_t>(name.size());
+		number = -1;
+		return;
+	}
+
+	// frame numbers are small, anything past nine digits is clamped
+	int64_t value = 0;
+	for (auto i = length; i < name.size(); ++i)
+	{
+		value = std::min<int64_t>(value * 10 + (name[i] - '0'), INT32_MAX);
+	}
+	number = static_cast<int32_t>(value);
+
+	// "megaman-run-0" belongs to "megaman-run", "plane1" to "plane"
+	if (length > 0 && (name[length - 1] == '-' || name[length - 1] == '_'))
+	{
+		--length;
+	}
+	animation_name_length = static_cast<uint32_t>(length);
+}
+
+std::string_view SpriteAtlas::GetString(const uint32_t offset, const uint32_t length) const
+{
+	// the tables aren't checked entry by entry when a file is mapped, so a bad offset reads as an empty name
+	if (static_cast<uint64_t>(offset) + length > m_header->stringsSize)
+	{
+		return {};
+	}
+	return { m_data + m_header->stringsOffset + offset, length };
+}
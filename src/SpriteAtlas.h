@@ -0,0 +1,119 @@
+#pragma once
+#ifndef __SPRITE_ATLAS__
+#define __SPRITE_ATLAS__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Frame.h"
+
+/*
+ * Frame table of a sprite sheet in a packed binary layout that is used straight from a memory mapped file,
+ * with nothing to parse. Frames are sorted by animation and then by their trailing number, so the frames
+ * of "megaman-run-0" to "megaman-run-3" sit next to each other and the animation table only keeps where
+ * each run starts. The sheet's image is either embedded after the tables or named as a file next to it.
+ *
+ * Layout, little endian, every offset from the start of the file:
+ *   Header
+ *   PackedFrame[frameCount]          sorted by (animation name, frame number)
+ *   PackedAnimation[animationCount]  sorted by name
+ *   string table                     frame names, the texture file name
+ *   embedded image                   optional, an encoded PNG or any other format SDL_image reads
+ */
+class SpriteAtlas
+{
+public:
+	static constexpr uint32_t MAGIC = 0x4C544153; // "SATL"
+	static constexpr uint32_t VERSION = 1;
+	static constexpr const char* FILE_EXTENSION = ".atlas";
+
+	/*
+	 * Maps a packed atlas. Given a text atlas it maps the packed file of the same name with the .atlas
+	 * extension when the converter has written one, otherwise it reads the text and packs it in memory.
+	 * Null when nothing could be read
+	 */
+	static std::shared_ptr<const SpriteAtlas> Load(const std::string& file_name);
+
+	// the text format, one "name x y w h" frame per line
+	static bool ReadText(const std::string& file_name, std::vector<Frame>& frames);
+	static std::vector<char> Pack(std::vector<Frame> frames, const std::string& texture_file_name, const std::vector<char>& embedded_image);
+	// the command line converter from the text format, embed_image copies the image file into the atlas
+	static bool PackFile(const std::string& text_file_name, const std::string& texture_file_name, const std::string& output_file_name, bool embed_image);
+
+	[[nodiscard]] int GetFrameCount() const;
+	[[nodiscard]] Frame GetFrame(int index) const;
+	// binary search of the frame table, -1 when there is no such frame
+	[[nodiscard]] int FindFrame(std::string_view name) const;
+
+	[[nodiscard]] int GetAnimationCount() const;
+	// the frames of "megaman-run" are megaman-run-0, megaman-run-1... in number order, false when there are none
+	[[nodiscard]] bool FindAnimation(std::string_view name, int& first_frame, int& frame_count) const;
+
+	// empty when the image is embedded or the atlas was packed without one
+	[[nodiscard]] std::string_view GetTextureFileName() const;
+	[[nodiscard]] bool HasEmbeddedImage() const;
+	[[nodiscard]] const char* GetEmbeddedImage() const;
+	[[nodiscard]] size_t GetEmbeddedImageSize() const;
+
+private:
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t frameCount;
+		uint32_t animationCount;
+		uint32_t framesOffset;
+		uint32_t animationsOffset;
+		uint32_t stringsOffset;
+		uint32_t stringsSize;
+		uint32_t textureNameOffset;
+		uint32_t textureNameLength;
+		uint32_t imageOffset;
+		uint32_t imageSize;
+	};
+
+	struct PackedFrame
+	{
+		// into the string table
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		// the name without its trailing number and separator is the animation the frame belongs to
+		uint32_t animationNameLength;
+		// the trailing number, -1 without one
+		int32_t number;
+		int32_t x;
+		int32_t y;
+		int32_t w;
+		int32_t h;
+	};
+
+	struct PackedAnimation
+	{
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t firstFrame;
+		uint32_t frameCount;
+	};
+
+	SpriteAtlas(std::shared_ptr<const void> storage, const char* data, size_t size);
+
+	// only checks that the header and the tables fit in size, O(1)
+	static bool IsValid(const char* data, size_t size);
+	static void SplitFrameName(std::string_view name, uint32_t& animation_name_length, int32_t& number);
+
+	[[nodiscard]] std::string_view GetString(uint32_t offset, uint32_t length) const;
+
+	// a MappedFile or a std::vector<char>, whichever the data lives in
+	std::shared_ptr<const void> m_storage;
+	const char* m_data;
+	size_t m_size;
+	const Header* m_header;
+	const PackedFrame* m_frames;
+	const PackedAnimation* m_animations;
+};
+
+#endif /* defined (__SPRITE_ATLAS__) */
@@ -2,21 +2,32 @@
 
 #include <utility>
 
-SpriteSheet::SpriteSheet(std::string name, SDL_Texture* texture)
-	:m_name(std::move(name)), m_pTexture(texture)
+SpriteSheet::SpriteSheet(std::string name, std::shared_ptr<const SpriteAtlas> atlas, SDL_Texture* texture)
+	:m_name(std::move(name)), m_pAtlas(std::move(atlas)), m_pTexture(texture)
 {}
 
-SpriteSheet::SpriteSheet(std::string name)
-	:m_name(std::move(name)), m_pTexture(nullptr)
-{
-}
-
 SpriteSheet::~SpriteSheet()
 = default;
 
 Frame SpriteSheet::GetFrame(const std::string& frame_name)
 {
-	return m_frames[frame_name];
+	return m_pAtlas->GetFrame(m_pAtlas->FindFrame(frame_name));
+}
+
+std::vector<Frame> SpriteSheet::GetAnimationFrames(const std::string_view animation_name) const
+{
+	std::vector<Frame> frames;
+	int first_frame = 0;
+	int frame_count = 0;
+	if (m_pAtlas->FindAnimation(animation_name, first_frame, frame_count))
+	{
+		frames.reserve(frame_count);
+		for (auto i = first_frame; i < first_frame + frame_count; ++i)
+		{
+			frames.push_back(m_pAtlas->GetFrame(i));
+		}
+	}
+	return frames;
 }
 
 SDL_Texture* SpriteSheet::GetTexture() const
@@ -24,12 +35,12 @@ SDL_Texture* SpriteSheet::GetTexture() const
 	return m_pTexture;
 }
 
-void SpriteSheet::SetTexture(SDL_Texture* texture)
+const std::shared_ptr<const SpriteAtlas>& SpriteSheet::GetAtlas() const
 {
-	m_pTexture = texture;
+	return m_pAtlas;
 }
 
-void SpriteSheet::AddFrame(const Frame& frame)
+void SpriteSheet::SetTexture(SDL_Texture* texture)
 {
-	m_frames[frame.name] = frame;
+	m_pTexture = texture;
 }
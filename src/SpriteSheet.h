@@ -1,32 +1,35 @@
 #pragma once
 #ifndef __SPRITE_SHEET__
 #define __SPRITE_SHEET__
+#include <memory>
+#include <string_view>
 #include <vector>
 #include "Frame.h"
-#include <unordered_map>
+#include "SpriteAtlas.h"
 #include <SDL.h>
 
 class SpriteSheet
 {
 public:
-	SpriteSheet(std::string name, SDL_Texture* texture);
-	explicit SpriteSheet(std::string name);
+	SpriteSheet(std::string name, std::shared_ptr<const SpriteAtlas> atlas, SDL_Texture* texture = nullptr);
 	~SpriteSheet();
 
 	// getters
 	Frame GetFrame(const std::string& frame_name);
+	// every frame of the animation in order, GetAnimationFrames("megaman-run") for megaman-run-0 to megaman-run-3
+	[[nodiscard]] std::vector<Frame> GetAnimationFrames(std::string_view animation_name) const;
 	[[nodiscard]] SDL_Texture* GetTexture() const;
+	[[nodiscard]] const std::shared_ptr<const SpriteAtlas>& GetAtlas() const;
 
 	// setters
-	void AddFrame(const Frame& frame);
 	void SetTexture(SDL_Texture* texture);
 	
 private:
 	std::string m_name;
 
-	std::unordered_map<std::string, Frame> m_frames;
+	std::shared_ptr<const SpriteAtlas> m_pAtlas;
 
 	SDL_Texture* m_pTexture;
 };
 
-#endif /* defined (__SPRITE_SHEET__) */
\ No newline at end of file
+#endif /* defined (__SPRITE_SHEET__) */
@@ -43,6 +43,16 @@ void StartScene::HandleEvents()
 	}
 }
 
+AssetManifest StartScene::GetManifest()
+{
+	AssetManifest manifest;
+	manifest.AddFont(Label::FontPath("Consolas"), Label::FontID("Consolas", 80), 80);
+	manifest.AddFont(Label::FontPath("Consolas"), Label::FontID("Consolas", 40), 40);
+	manifest.AddTexture("../Assets/textures/ship3.png", "ship");
+	manifest.AddTexture("../Assets/textures/StartButton.png", "startButton");
+	return manifest;
+}
+
 void StartScene::Start()
 {
 	const SDL_Color blue = { 0, 0, 255, 255 };
@@ -0,0 +1,12 @@
+#pragma once
+#ifndef __STEERING_BEHAVIOUR__
+#define __STEERING_BEHAVIOUR__
+enum class SteeringBehaviour {
+	SEEK,
+	FLEE,
+	ARRIVE,
+	SEPARATION,
+	ALIGNMENT,
+	NUM_OF_STEERING_BEHAVIOURS
+};
+#endif /* defined (__STEERING_BEHAVIOUR__) */
@@ -0,0 +1,409 @@
+#include "SteeringSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "ComponentStore.h"
+#include "Config.h"
+
+namespace
+{
+	constexpr float EPSILON = 0.0001f;
+
+	glm::vec2 Desire(const glm::vec2 offset, const float speed)
+	{
+		const float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+		return length > EPSILON ? offset * (speed / length) : glm::vec2(0.0f, 0.0f);
+	}
+
+	glm::vec2 ClampLength(const glm::vec2 vector, const float max_length)
+	{
+		const float length_squared = vector.x * vector.x + vector.y * vector.y;
+		if (length_squared <= max_length * max_length)
+		{
+			return vector;
+		}
+		return vector * (max_length / std::sqrt(length_squared));
+	}
+}
+
+SteeringSystem::SteeringSystem() :
+	m_cellSize(1.0f), m_bucketMask(0), m_neighbourRadius(50.0f), m_separationRadius(25.0f), m_slowingRadius(100.0f)
+{
+	m_weights.fill(1.0f);
+	m_weights[static_cast<size_t>(SteeringBehaviour::SEPARATION)] = 1.5f;
+}
+
+SteeringSystem::~SteeringSystem()
+= default;
+
+void SteeringSystem::Add(const uint32_t entity, const uint32_t behaviours, const float max_speed, const float max_force)
+{
+	if (Contains(entity))
+	{
+		const auto agent = m_entityToAgent[entity];
+		m_behaviours[agent] = behaviours;
+		m_maxSpeeds[agent] = max_speed;
+		m_maxForces[agent] = max_force;
+		return;
+	}
+
+	if (entity >= m_entityToAgent.size())
+	{
+		m_entityToAgent.resize(entity + 1, INVALID_AGENT);
+	}
+	m_entityToAgent[entity] = static_cast<uint32_t>(m_entities.size());
+	m_entities.push_back(entity);
+	m_behaviours.push_back(behaviours);
+	m_targets.emplace_back(0.0f, 0.0f);
+	m_maxSpeeds.push_back(max_speed);
+	m_maxForces.push_back(max_force);
+}
+
+void SteeringSystem::Remove(const uint32_t entity)
+{
+	if (!Contains(entity))
+	{
+		return;
+	}
+
+	// swap the last agent into the hole to keep the arrays packed
+	const auto agent = m_entityToAgent[entity];
+	const auto last = static_cast<uint32_t>(m_entities.size() - 1);
+	m_entities[agent] = m_entities[last];
+	m_behaviours[agent] = m_behaviours[last];
+	m_targets[agent] = m_targets[last];
+	m_maxSpeeds[agent] = m_maxSpeeds[last];
+	m_maxForces[agent] = m_maxForces[last];
+	m_entityToAgent[m_entities[agent]] = agent;
+
+	m_entities.pop_back();
+	m_behaviours.pop_back();
+	m_targets.pop_back();
+	m_maxSpeeds.pop_back();
+	m_maxForces.pop_back();
+	m_entityToAgent[entity] = INVALID_AGENT;
+}
+
+void SteeringSystem::Clear()
+{
+	m_entities.clear();
+	m_behaviours.clear();
+	m_targets.clear();
+	m_maxSpeeds.clear();
+	m_maxForces.clear();
+	m_entityToAgent.clear();
+}
+
+bool SteeringSystem::Contains(const uint32_t entity) const
+{
+	return entity < m_entityToAgent.size() && m_entityToAgent[entity] != INVALID_AGENT;
+}
+
+int SteeringSystem::GetAgentCount() const
+{
+	return static_cast<int>(m_entities.size());
+}
+
+void SteeringSystem::SetBehaviours(const uint32_t entity, const uint32_t behaviours)
+{
+	if (Contains(entity))
+	{
+		m_behaviours[m_entityToAgent[entity]] = behaviours;
+	}
+}
+
+void SteeringSystem::SetTarget(const uint32_t entity, const glm::vec2 target)
+{
+	if (Contains(entity))
+	{
+		m_targets[m_entityToAgent[entity]] = target;
+	}
+}
+
+void SteeringSystem::SetMaxSpeed(const uint32_t entity, const float max_speed)
+{
+	if (Contains(entity))
+	{
+		m_maxSpeeds[m_entityToAgent[entity]] = max_speed;
+	}
+}
+
+void SteeringSystem::SetMaxForce(const uint32_t entity, const float max_force)
+{
+	if (Contains(entity))
+	{
+		m_maxForces[m_entityToAgent[entity]] = max_force;
+	}
+}
+
+void SteeringSystem::SetWeight(const SteeringBehaviour behaviour, const float weight)
+{
+	m_weights[static_cast<size_t>(behaviour)] = weight;
+}
+
+float SteeringSystem::GetWeight(const SteeringBehaviour behaviour) const
+{
+	return m_weights[static_cast<size_t>(behaviour)];
+}
+
+void SteeringSystem::SetNeighbourRadius(const float radius)
+{
+	m_neighbourRadius = std::max(radius, EPSILON);
+}
+
+void SteeringSystem::SetSeparationRadius(const float radius)
+{
+	m_separationRadius = std::max(radius, EPSILON);
+}
+
+void SteeringSystem::SetSlowingRadius(const float radius)
+{
+	m_slowingRadius = std::max(radius, EPSILON);
+}
+
+void SteeringSystem::Update(const float delta_time)
+{
+	if (m_entities.empty())
+	{
+		return;
+	}
+
+	Gather();
+	BuildSpatialHash();
+	ComputeForces();
+	Apply(delta_time);
+	Scatter();
+}
+
+void SteeringSystem::RunBenchmark(const int agent_count, const int frame_count, const unsigned int seed)
+{
+	std::mt19937 random_generator(seed);
+	std::uniform_real_distribution<float> x_position(0.0f, static_cast<float>(Config::SCREEN_WIDTH));
+	std::uniform_real_distribution<float> y_position(0.0f, static_cast<float>(Config::SCREEN_HEIGHT));
+	std::uniform_real_distribution<float> speed(-60.0f, 60.0f);
+
+	SteeringSystem steering_system;
+	const auto flocking = BehaviourBit(SteeringBehaviour::SEEK) | BehaviourBit(SteeringBehaviour::SEPARATION) | BehaviourBit(SteeringBehaviour::ALIGNMENT);
+	const auto centre = glm::vec2(Config::SCREEN_WIDTH * 0.5f, Config::SCREEN_HEIGHT * 0.5f);
+	const auto screen = glm::vec2(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+
+	// the entity ids only index the agent table, the positions and velocities Gather would copy out of the
+	// ComponentStore are filled in directly instead
+	for (int i = 0; i < agent_count; ++i)
+	{
+		const auto entity = static_cast<uint32_t>(i);
+		steering_system.Add(entity, flocking, 120.0f, 240.0f);
+		steering_system.SetTarget(entity, centre);
+		steering_system.m_positions.emplace_back(x_position(random_generator), y_position(random_generator));
+		steering_system.m_velocities.emplace_back(speed(random_generator), speed(random_generator));
+	}
+	steering_system.m_forces.resize(agent_count);
+	steering_system.SetWeight(SteeringBehaviour::SEEK, 0.25f);
+
+	const float delta_time = 1.0f / 60.0f;
+	double steering_milliseconds = 0.0;
+	for (int frame = 0; frame < frame_count; ++frame)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		steering_system.BuildSpatialHash();
+		steering_system.ComputeForces();
+		steering_system.Apply(delta_time);
+		steering_milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// what Integrate and ConstrainToBounds would do to simulated agents
+		for (int i = 0; i < agent_count; ++i)
+		{
+			auto& position = steering_system.m_positions[i];
+			auto& velocity = steering_system.m_velocities[i];
+			position += velocity * delta_time;
+			if (position.x < 0.0f || position.x > screen.x)
+			{
+				position.x = std::clamp(position.x, 0.0f, screen.x);
+				velocity.x = 0.0f;
+			}
+			if (position.y < 0.0f || position.y > screen.y)
+			{
+				position.y = std::clamp(position.y, 0.0f, screen.y);
+				velocity.y = 0.0f;
+			}
+		}
+	}
+
+	std::cout << "Steering benchmark: " << agent_count << " agents, " << frame_count << " frames, "
+		<< steering_milliseconds / frame_count << " ms per frame" << std::endl;
+}
+
+void SteeringSystem::Gather()
+{
+	auto& store = ComponentStore::Instance();
+	const auto count = m_entities.size();
+	m_positions.resize(count);
+	m_velocities.resize(count);
+	m_forces.resize(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_positions[i] = store.GetTransform(m_entities[i]).position;
+		m_velocities[i] = store.GetRigidBody(m_entities[i]).velocity;
+	}
+}
+
+void SteeringSystem::BuildSpatialHash()
+{
+	// cells as wide as the largest radius, so every neighbour is within the 3x3 cells around an agent
+	m_cellSize = std::max(m_neighbourRadius, m_separationRadius);
+
+	const auto count = static_cast<uint32_t>(m_entities.size());
+	uint32_t bucket_count = 16;
+	while (bucket_count < count * 2)
+	{
+		bucket_count *= 2;
+	}
+	m_bucketMask = bucket_count - 1;
+
+	// counting sort of the agents by bucket, each bucket is filled from its end so its count becomes its start
+	m_bucketStart.assign(bucket_count + 1, 0);
+	m_agentBucket.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const auto bucket = GetBucket(static_cast<int>(std::floor(m_positions[i].x / m_cellSize)),
+			static_cast<int>(std::floor(m_positions[i].y / m_cellSize)));
+		m_agentBucket[i] = bucket;
+		++m_bucketStart[bucket];
+	}
+	for (uint32_t bucket = 1; bucket < bucket_count; ++bucket)
+	{
+		m_bucketStart[bucket] += m_bucketStart[bucket - 1];
+	}
+
+	m_bucketAgents.resize(count);
+	for (uint32_t i = count; i > 0; --i)
+	{
+		m_bucketAgents[--m_bucketStart[m_agentBucket[i - 1]]] = i - 1;
+	}
+	m_bucketStart[bucket_count] = count;
+}
+
+uint32_t SteeringSystem::GetBucket(const int cell_x, const int cell_y) const
+{
+	return ((static_cast<uint32_t>(cell_x) * 73856093u) ^ (static_cast<uint32_t>(cell_y) * 19349663u)) & m_bucketMask;
+}
+
+void SteeringSystem::ComputeForces()
+{
+	const float seek_weight = m_weights[static_cast<size_t>(SteeringBehaviour::SEEK)];
+	const float flee_weight = m_weights[static_cast<size_t>(SteeringBehaviour::FLEE)];
+	const float arrive_weight = m_weights[static_cast<size_t>(SteeringBehaviour::ARRIVE)];
+	const float separation_weight = m_weights[static_cast<size_t>(SteeringBehaviour::SEPARATION)];
+	const float alignment_weight = m_weights[static_cast<size_t>(SteeringBehaviour::ALIGNMENT)];
+	const float neighbour_radius_squared = m_neighbourRadius * m_neighbourRadius;
+	const float separation_radius_squared = m_separationRadius * m_separationRadius;
+	const auto neighbour_behaviours = BehaviourBit(SteeringBehaviour::SEPARATION) | BehaviourBit(SteeringBehaviour::ALIGNMENT);
+
+	const auto count = m_entities.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto behaviours = m_behaviours[i];
+		const auto position = m_positions[i];
+		const auto velocity = m_velocities[i];
+		const float max_speed = m_maxSpeeds[i];
+		glm::vec2 force(0.0f, 0.0f);
+
+		if (behaviours & BehaviourBit(SteeringBehaviour::SEEK))
+		{
+			force += (Desire(m_targets[i] - position, max_speed) - velocity) * seek_weight;
+		}
+		if (behaviours & BehaviourBit(SteeringBehaviour::FLEE))
+		{
+			force += (Desire(position - m_targets[i], max_speed) - velocity) * flee_weight;
+		}
+		if (behaviours & BehaviourBit(SteeringBehaviour::ARRIVE))
+		{
+			const auto offset = m_targets[i] - position;
+			const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+			force += (Desire(offset, max_speed * std::min(distance / m_slowingRadius, 1.0f)) - velocity) * arrive_weight;
+		}
+
+		if (behaviours & neighbour_behaviours)
+		{
+			glm::vec2 separation(0.0f, 0.0f);
+			glm::vec2 alignment(0.0f, 0.0f);
+			int neighbour_count = 0;
+
+			// two of the nine cells can share a bucket, only visit each bucket once
+			uint32_t visited[9];
+			int visited_count = 0;
+			const int cell_x = static_cast<int>(std::floor(position.x / m_cellSize));
+			const int cell_y = static_cast<int>(std::floor(position.y / m_cellSize));
+			for (int offset_y = -1; offset_y <= 1 && neighbour_count < MAX_NEIGHBOURS; ++offset_y)
+			{
+				for (int offset_x = -1; offset_x <= 1 && neighbour_count < MAX_NEIGHBOURS; ++offset_x)
+				{
+					const auto bucket = GetBucket(cell_x + offset_x, cell_y + offset_y);
+					if (std::find(visited, visited + visited_count, bucket) != visited + visited_count)
+					{
+						continue;
+					}
+					visited[visited_count++] = bucket;
+
+					for (auto k = m_bucketStart[bucket]; k < m_bucketStart[bucket + 1] && neighbour_count < MAX_NEIGHBOURS; ++k)
+					{
+						const auto other = m_bucketAgents[k];
+						const auto difference = position - m_positions[other];
+						const float distance_squared = difference.x * difference.x + difference.y * difference.y;
+						if (other == i || distance_squared > neighbour_radius_squared)
+						{
+							continue;
+						}
+
+						++neighbour_count;
+						alignment += m_velocities[other];
+						if (distance_squared < separation_radius_squared && distance_squared > EPSILON)
+						{
+							// closer agents push harder
+							separation += difference / distance_squared;
+						}
+					}
+				}
+			}
+
+			if (behaviours & BehaviourBit(SteeringBehaviour::SEPARATION) && (separation.x != 0.0f || separation.y != 0.0f))
+			{
+				force += (Desire(separation, max_speed) - velocity) * separation_weight;
+			}
+			if (behaviours & BehaviourBit(SteeringBehaviour::ALIGNMENT) && neighbour_count > 0)
+			{
+				const auto desired = Desire(alignment, max_speed);
+				if (desired.x != 0.0f || desired.y != 0.0f)
+				{
+					force += (desired - velocity) * alignment_weight;
+				}
+			}
+		}
+
+		m_forces[i] = ClampLength(force, m_maxForces[i]);
+	}
+}
+
+void SteeringSystem::Apply(const float delta_time)
+{
+	const auto count = m_entities.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_velocities[i] = ClampLength(m_velocities[i] + m_forces[i] * delta_time, m_maxSpeeds[i]);
+	}
+}
+
+void SteeringSystem::Scatter()
+{
+	auto& store = ComponentStore::Instance();
+	const auto count = m_entities.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		store.GetRigidBody(m_entities[i]).velocity = m_velocities[i];
+	}
+}
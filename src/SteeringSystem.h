@@ -0,0 +1,107 @@
+#pragma once
+#ifndef __STEERING_SYSTEM__
+#define __STEERING_SYSTEM__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "SteeringBehaviour.h"
+
+/*
+ * Steers every registered entity in one pass over contiguous arrays. Each Update copies the positions and
+ * velocities out of the ComponentStore, buckets them into a spatial hash so separation and alignment only
+ * look at nearby agents, blends the weighted behaviours into one force per agent and writes the new
+ * velocity back to its RigidBody. Agents should be simulated so ComponentStore::Integrate moves them.
+ */
+class SteeringSystem
+{
+public:
+	SteeringSystem();
+	~SteeringSystem();
+
+	static constexpr uint32_t INVALID_AGENT = UINT32_MAX;
+
+	// behaviours is a mask of BehaviourBit values
+	void Add(uint32_t entity, uint32_t behaviours, float max_speed, float max_force);
+	void Remove(uint32_t entity);
+	void Clear();
+	[[nodiscard]] bool Contains(uint32_t entity) const;
+	[[nodiscard]] int GetAgentCount() const;
+
+	static constexpr uint32_t BehaviourBit(SteeringBehaviour behaviour)
+	{
+		return 1u << static_cast<uint32_t>(behaviour);
+	}
+
+	// per agent
+	void SetBehaviours(uint32_t entity, uint32_t behaviours);
+	// point seek, flee and arrive steer relative to
+	void SetTarget(uint32_t entity, glm::vec2 target);
+	void SetMaxSpeed(uint32_t entity, float max_speed);
+	void SetMaxForce(uint32_t entity, float max_force);
+
+	// shared by every agent
+	void SetWeight(SteeringBehaviour behaviour, float weight);
+	[[nodiscard]] float GetWeight(SteeringBehaviour behaviour) const;
+	// alignment looks this far, separation only pushes away from agents inside the separation radius
+	void SetNeighbourRadius(float radius);
+	void SetSeparationRadius(float radius);
+	// arrive slows down inside this distance of the target
+	void SetSlowingRadius(float radius);
+
+	// call before the ComponentStore update so the new velocities are integrated the same frame
+	void Update(float delta_time);
+
+	/*
+	 * Times the steering pass of Update on agent_count flocking agents spread over the screen and prints the
+	 * results. The agents only live in the benchmark's own arrays, so the ComponentStore is never touched
+	 */
+	static void RunBenchmark(int agent_count, int frame_count, unsigned int seed);
+
+private:
+	/*
+	 * Most agents each one looks at, keeps crowded cells from going quadratic. They are the first ones
+	 * inside the neighbour radius in bucket order, not the nearest
+	 */
+	static constexpr int MAX_NEIGHBOURS = 16;
+
+	void Gather();
+	void BuildSpatialHash();
+	[[nodiscard]] uint32_t GetBucket(int cell_x, int cell_y) const;
+	void ComputeForces();
+	void Apply(float delta_time);
+	// writes the new velocities back to the ComponentStore, the counterpart of Gather
+	void Scatter();
+
+	// dense, one entry per agent
+	std::vector<uint32_t> m_entities;
+	std::vector<uint32_t> m_behaviours;
+	std::vector<glm::vec2> m_targets;
+	std::vector<float> m_maxSpeeds;
+	std::vector<float> m_maxForces;
+
+	// sparse, indexed by entity id
+	std::vector<uint32_t> m_entityToAgent;
+
+	// per frame copies and results
+	std::vector<glm::vec2> m_positions;
+	std::vector<glm::vec2> m_velocities;
+	std::vector<glm::vec2> m_forces;
+
+	// spatial hash, agents sorted by bucket with m_bucketStart[b] .. m_bucketStart[b + 1] holding bucket b
+	float m_cellSize;
+	uint32_t m_bucketMask;
+	std::vector<uint32_t> m_bucketStart;
+	std::vector<uint32_t> m_bucketAgents;
+	std::vector<uint32_t> m_agentBucket;
+
+	std::array<float, static_cast<size_t>(SteeringBehaviour::NUM_OF_STEERING_BEHAVIOURS)> m_weights;
+	float m_neighbourRadius;
+	float m_separationRadius;
+	float m_slowingRadius;
+};
+
+#endif /* defined (__STEERING_SYSTEM__) */
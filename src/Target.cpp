@@ -5,8 +5,9 @@
 Target::Target()
 {
 	TextureManager::Instance().Load("../Assets/textures/Circle.png","circle");
+	m_texture = TextureManager::Instance().GetTextureHandle("circle");
 
-	const auto size = TextureManager::Instance().GetTextureSize("circle");
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 	GetTransform()->position = glm::vec2(100.0f, 100.0f);
@@ -22,7 +23,7 @@ Target::~Target()
 void Target::Draw()
 {
 	// draw the target
-	TextureManager::Instance().Draw("circle", GetTransform()->position, 0, 255, true);
+	TextureManager::Instance().Draw(m_texture, GetTransform()->position, 0, 255, true);
 }
 
 void Target::Update()
@@ -2,6 +2,7 @@
 #ifndef __TARGET__
 #define __TARGET__
 
+#include "AssetRegistry.h"
 #include "DisplayObject.h"
 
 class Target final : public DisplayObject {
@@ -18,6 +19,8 @@ private:
 	void Move();
 	void CheckBounds();
 	void Reset();
+
+	TextureHandle m_texture;
 };
 
 
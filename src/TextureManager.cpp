@@ -2,21 +2,56 @@
 #include <SDL_image.h>
 #include "Game.h"
 #include <utility>
-#include <fstream>
-#include <sstream>
 #include "Frame.h"
-#include <iterator>
+#include <algorithm>
 #include "Renderer.h"
+#include "SkylinePacker.h"
 
-TextureManager::TextureManager()
-= default;
+namespace
+{
+	constexpr int DEFAULT_UPLOAD_BUDGET = 16;
+	// drawn size of the placeholder before the image's own size is known
+	constexpr int PLACEHOLDER_SIZE = 32;
+
+	// PackTextures pages, shrunk to the renderer's own limit if it is smaller
+	constexpr int PAGE_SIZE = 2048;
+	// transparent gap between packed images so linear filtering never samples a neighbour
+	constexpr int PAGE_PADDING = 2;
+	// anything bigger keeps a texture of its own, it would take up most of a page
+	constexpr int MAX_PACKED_SIZE = 512;
+
+	// the image a texture_file_name of "" leaves a sprite sheet with is the one its atlas names
+	std::string GetAtlasTextureFileName(const SpriteAtlas& atlas, const std::string& texture_file_name)
+	{
+		return texture_file_name.empty() ? std::string(atlas.GetTextureFileName()) : texture_file_name;
+	}
+
+	// reads no SDL renderer state, safe on the decode workers
+	SDL_Surface* LoadImage(const std::string& file_name, const SpriteAtlas* atlas)
+	{
+		if (atlas != nullptr && atlas->HasEmbeddedImage())
+		{
+			return IMG_Load_RW(SDL_RWFromConstMem(atlas->GetEmbeddedImage(), static_cast<int>(atlas->GetEmbeddedImageSize())), 1);
+		}
+		return IMG_Load(file_name.c_str());
+	}
+}
+
+TextureManager::TextureManager() : m_uploadBudget(DEFAULT_UPLOAD_BUDGET), m_decodeWorkerCount(1)
+{
+	// leave a core for the main thread
+	const int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+	m_decodeWorkerCount = std::max(hardware_threads - 1, 1);
+}
 
 TextureManager::~TextureManager()
-= default;
+{
+	Shutdown();
+}
 
 inline bool TextureManager::TextureExists(const std::string & id)
 {
-	return m_textureMap.find(id) != m_textureMap.end();
+	return m_textures.IsLoaded(m_textures.Find(id));
 }
 
 bool TextureManager::SpriteSheetExists(const std::string & sprite_sheet_name)
@@ -24,24 +59,48 @@ bool TextureManager::SpriteSheetExists(const std::string & sprite_sheet_name)
 	return m_spriteSheetMap.find(sprite_sheet_name) != m_spriteSheetMap.end();
 }
 
+TextureHandle TextureManager::GetTextureHandle(const AssetName id)
+{
+	return m_textures.Intern(id);
+}
+
+void TextureManager::StoreTexture(const TextureHandle handle, std::shared_ptr<SDL_Texture> texture)
+{
+	// the size is queried once here instead of on every draw
+	TextureEntry entry;
+	SDL_QueryTexture(texture.get(), nullptr, nullptr, &entry.width, &entry.height);
+	entry.texture = std::move(texture);
+	m_textures.Set(handle, std::move(entry));
+}
+
 bool TextureManager::Load(const std::string & file_name, const std::string & id)
 {
-	if (TextureExists(id))
+	const auto handle = m_textures.Intern(id);
+	if (m_textures.IsLoaded(handle))
 	{
 		return true;
 	}
 
-	const auto temp_surface(Config::MakeResource(IMG_Load(file_name.c_str())));
-	if (temp_surface == nullptr)
+	return AddSurface(handle, Config::MakeResource(IMG_Load(file_name.c_str())));
+}
+
+bool TextureManager::AddSurface(const TextureHandle handle, const std::shared_ptr<SDL_Surface>& surface)
+{
+	if (m_textures.IsLoaded(handle))
+	{
+		return true;
+	}
+
+	if (surface == nullptr)
 	{
 		return false;
 	}
 
 	// everything went ok, add the texture to our list
-	if (const auto texture(Config::MakeResource(SDL_CreateTextureFromSurface(Renderer::Instance().GetRenderer(), temp_surface.get()))); 
+	if (const auto texture(Config::MakeResource(SDL_CreateTextureFromSurface(Renderer::Instance().GetRenderer(), surface.get())));
 		texture != nullptr)
 	{
-		m_textureMap[id] = texture;
+		StoreTexture(handle, texture);
 		return true;
 	}
 	return false;
@@ -52,85 +111,408 @@ bool TextureManager::LoadSpriteSheet(
 	const std::string & texture_file_name,
 	const std::string & sprite_sheet_name)
 {
-	std::fstream data_file; // create file stream object
-	const std::string delimiter = " ";
+	// several objects share one sheet, only the first of them loads it
+	if (SpriteSheetExists(sprite_sheet_name))
+	{
+		return true;
+	}
+
+	const auto atlas = SpriteAtlas::Load(data_file_name);
+	if (atlas == nullptr)
+	{
+		std::cout << "error opening file " << data_file_name << std::endl;
+		return false;
+	}
+
+	// load the sprite texture and store it in the textureMap
+	const auto handle = m_textures.Intern(sprite_sheet_name);
+	if (!m_textures.IsLoaded(handle))
+	{
+		AddSurface(handle, Config::MakeResource(LoadImage(GetAtlasTextureFileName(*atlas, texture_file_name), atlas.get())));
+	}
+
+	return AddSpriteSheet(sprite_sheet_name, atlas);
+}
+
+bool TextureManager::AddSpriteSheet(const std::string & sprite_sheet_name, std::shared_ptr<const SpriteAtlas> atlas)
+{
+	if (SpriteSheetExists(sprite_sheet_name))
+	{
+		return true;
+	}
+
+	// create a new spritesheet object that points at the texture of the same name
+	m_spriteSheetMap[sprite_sheet_name] = new SpriteSheet(sprite_sheet_name, std::move(atlas), GetTexture(sprite_sheet_name));
+
+	return true;
+}
+
+TextureHandle TextureManager::LoadAsync(const std::string & file_name, const std::string & id)
+{
+	const auto handle = m_textures.Intern(id);
+	QueueDecode(handle, file_name, nullptr);
+	return handle;
+}
+
+TextureHandle TextureManager::LoadSpriteSheetAsync(
+	const std::string & data_file_name,
+	const std::string & texture_file_name,
+	const std::string & sprite_sheet_name)
+{
+	const auto handle = m_textures.Intern(sprite_sheet_name);
+	if (const auto it = m_spriteSheetMap.find(sprite_sheet_name); it != m_spriteSheetMap.end())
+	{
+		// nothing to do unless the texture was removed since, the atlas is already mapped
+		const auto& atlas = it->second->GetAtlas();
+		QueueDecode(handle, GetAtlasTextureFileName(*atlas, texture_file_name), atlas);
+		return handle;
+	}
+
+	auto atlas = SpriteAtlas::Load(data_file_name);
+	if (atlas == nullptr)
+	{
+		std::cout << "error opening file " << data_file_name << std::endl;
+		return handle;
+	}
+
+	// the sheet is given its texture when the upload happens
+	QueueDecode(handle, GetAtlasTextureFileName(*atlas, texture_file_name), atlas);
+	AddSpriteSheet(sprite_sheet_name, std::move(atlas));
+	return handle;
+}
+
+bool TextureManager::IsLoaded(const TextureHandle handle) const
+{
+	return m_textures.IsLoaded(handle);
+}
+
+bool TextureManager::IsPending(const TextureHandle handle) const
+{
+	return handle.index < m_textures.GetSlotCount() && m_textures.Get(handle).pending;
+}
+
+int TextureManager::GetPendingLoadCount() const
+{
+	return m_pendingLoadCount;
+}
+
+void TextureManager::UploadPendingTextures()
+{
+	if (m_pendingLoadCount == 0)
+	{
+		return;
+	}
+
+	CollectDecodedImages();
+
+	// creating a texture copies the whole image to the renderer, so the rest wait for the next frame
+	for (auto uploaded = 0; uploaded < m_uploadBudget && !m_uploads.empty(); ++uploaded)
+	{
+		UploadDecodedImage(m_uploads.front());
+		m_uploads.pop_front();
+	}
+}
+
+void TextureManager::FinishPendingLoads()
+{
+	while (true)
+	{
+		CollectDecodedImages();
+		for (; !m_uploads.empty(); m_uploads.pop_front())
+		{
+			UploadDecodedImage(m_uploads.front());
+		}
+
+		if (m_pendingLoadCount == 0)
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_decodeMutex);
+		m_decodedCondition.wait(lock, [this] { return !m_decoding || !m_decodedImages.empty(); });
+		if (m_decodedImages.empty())
+		{
+			return;
+		}
+	}
+}
+
+void TextureManager::SetUploadBudget(const int max_uploads)
+{
+	m_uploadBudget = std::max(max_uploads, 1);
+}
+
+int TextureManager::GetUploadBudget() const
+{
+	return m_uploadBudget;
+}
+
+void TextureManager::SetDecodeWorkerCount(const int count)
+{
+	m_decodeWorkerCount = std::max(count, 1);
+}
+
+void TextureManager::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_decoding = false;
+		m_decodeRequests.clear();
+	}
+	m_decodeRequestCondition.notify_all();
+	m_decodedCondition.notify_all();
 
-	// open the text data file
-	data_file.open(data_file_name, std::ios::in);
+	for (auto& worker : m_decodeWorkers)
+	{
+		worker.join();
+	}
+	m_decodeWorkers.clear();
 
-	// create a new spritesheet object and allocate memory for it
-	auto sprite_sheet = new SpriteSheet(sprite_sheet_name);
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_decodedImages.clear();
+	}
+	m_uploads.clear();
+	for (uint32_t index = 0; index < m_textures.GetSlotCount(); ++index)
+	{
+		m_textures.Get(TextureHandle{ index }).pending = false;
+	}
+	m_pendingLoadCount = 0;
+	++m_loadGeneration;
+	m_placeholder.reset();
+}
 
-	// if the file successfully opened
-	if (data_file)
+SDL_Texture* TextureManager::GetDrawTexture(const TextureHandle handle, bool& is_placeholder)
+{
+	is_placeholder = false;
+	if (m_textures.IsLoaded(handle))
+	{
+		return m_textures.Get(handle).texture.get();
+	}
+	if (IsPending(handle))
 	{
-		std::string input_line;
-		// read one line at a time
-		while (std::getline(data_file, input_line))
+		is_placeholder = true;
+		return GetPlaceholder();
+	}
+	return nullptr;
+}
+
+SDL_Texture* TextureManager::GetPlaceholder()
+{
+	if (m_placeholder == nullptr)
+	{
+		// a 2x2 magenta and black checker, stretched over whatever it stands in for
+		constexpr Uint32 pixels[] = { 0xFF00FFFF, 0x000000FF, 0x000000FF, 0xFF00FFFF };
+		m_placeholder = Config::MakeResource(SDL_CreateTexture(Renderer::Instance().GetRenderer(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 2, 2));
+		if (m_placeholder != nullptr)
 		{
-			Frame frame;
-			size_t line_position = 0;
-			std::vector<std::string> tokens;
+			SDL_UpdateTexture(m_placeholder.get(), nullptr, pixels, 2 * sizeof(Uint32));
+		}
+	}
+	return m_placeholder.get();
+}
+
+Uint32 TextureManager::GetNativeFormat()
+{
+	if (m_nativeFormat != SDL_PIXELFORMAT_UNKNOWN)
+	{
+		return m_nativeFormat;
+	}
 
-			for (auto i = 0; i < 5; ++i)
+	// the first format the renderer takes that keeps transparency, SDL lists its preferred format first
+	if (SDL_RendererInfo info; SDL_GetRendererInfo(Renderer::Instance().GetRenderer(), &info) == 0)
+	{
+		for (Uint32 i = 0; i < info.num_texture_formats; ++i)
+		{
+			if (SDL_ISPIXELFORMAT_ALPHA(info.texture_formats[i]))
 			{
-				line_position = input_line.find(delimiter);
-				tokens.push_back(input_line.substr(0, line_position));
-				input_line.erase(0, line_position + 1);
+				m_nativeFormat = info.texture_formats[i];
+				break;
 			}
+		}
+	}
+	return m_nativeFormat;
+}
+
+void TextureManager::QueueDecode(const TextureHandle handle, const std::string& file_name, std::shared_ptr<const SpriteAtlas> atlas)
+{
+	if (m_textures.IsLoaded(handle) || m_textures.Get(handle).pending)
+	{
+		return;
+	}
+
+	if (!m_decoding)
+	{
+		StartDecodeWorkers();
+	}
+
+	// an atlas that doesn't embed its image has no reason to go along
+	if (atlas != nullptr && !atlas->HasEmbeddedImage())
+	{
+		atlas.reset();
+	}
+
+	m_textures.Get(handle).pending = true;
+	++m_pendingLoadCount;
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_decodeRequests.push_back({ handle, m_loadGeneration, GetNativeFormat(), file_name, std::move(atlas) });
+	}
+	m_decodeRequestCondition.notify_one();
+}
+
+void TextureManager::ApplyColour(SDL_Texture* texture, const TextureEntry& entry) const
+{
+	if (entry.packed)
+	{
+		SDL_SetTextureColorMod(texture, entry.colour.r, entry.colour.g, entry.colour.b);
+	}
+}
+
+void TextureManager::CollectDecodedImages()
+{
+	std::deque<DecodedImage> decoded_images;
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		decoded_images.swap(m_decodedImages);
+	}
 
-			frame.name = tokens[0];
-			frame.x = std::stoi(tokens[1]);
-			frame.y = std::stoi(tokens[2]);
-			frame.w = std::stoi(tokens[3]);
-			frame.h = std::stoi(tokens[4]);
+	for (auto& image : decoded_images)
+	{
+		if (image.generation != m_loadGeneration)
+		{
+			continue;
+		}
 
-			// add the new frame to the spritesheet
-			sprite_sheet->AddFrame(frame);
+		auto& entry = m_textures.Get(image.handle);
+		if (!entry.pending || image.surface == nullptr)
+		{
+			// failed, or loaded some other way in the meantime
+			if (entry.pending)
+			{
+				std::cout << "error loading texture " << m_textures.GetName(image.handle) << std::endl;
+				entry.pending = false;
+			}
+			--m_pendingLoadCount;
+			continue;
 		}
+
+		// placeholders take the real size straight away, before the texture itself is ready
+		entry.width = image.surface->w;
+		entry.height = image.surface->h;
+		m_uploads.push_back(std::move(image));
 	}
-	else
+}
+
+void TextureManager::UploadDecodedImage(const DecodedImage& image)
+{
+	--m_pendingLoadCount;
+	if (!m_textures.Get(image.handle).pending)
 	{
-		std::cout << "error opening file" << std::endl;
-		return false;
+		return;
 	}
 
-	data_file.close();
+	const auto texture(Config::MakeResource(SDL_CreateTextureFromSurface(Renderer::Instance().GetRenderer(), image.surface.get())));
+	if (texture == nullptr)
+	{
+		std::cout << "error creating texture " << m_textures.GetName(image.handle) << std::endl;
+		m_textures.Get(image.handle).pending = false;
+		return;
+	}
 
-	// load the sprite texture and store it in the textureMap
-	Load(texture_file_name, sprite_sheet_name);
+	StoreTexture(image.handle, texture);
+	if (const auto it = m_spriteSheetMap.find(m_textures.GetName(image.handle)); it != m_spriteSheetMap.end())
+	{
+		it->second->SetTexture(texture.get());
+	}
+}
 
-	// get a pointer to the Texture and store it in the new spritesheet object
-	sprite_sheet->SetTexture(GetTexture(sprite_sheet_name));
+void TextureManager::StartDecodeWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_decoding = true;
+	}
 
-	// store the new spritesheet in the spriteSheetMap
-	m_spriteSheetMap[sprite_sheet_name] = sprite_sheet;
+	for (int i = 0; i < m_decodeWorkerCount; ++i)
+	{
+		m_decodeWorkers.emplace_back(&TextureManager::DecodeLoop, this);
+	}
+}
 
-	// cleanup
-	sprite_sheet = nullptr;
+void TextureManager::DecodeLoop()
+{
+	while (true)
+	{
+		DecodeRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_decodeMutex);
+			m_decodeRequestCondition.wait(lock, [this] { return !m_decoding || !m_decodeRequests.empty(); });
+			if (!m_decoding)
+			{
+				return;
+			}
+			request = std::move(m_decodeRequests.front());
+			m_decodeRequests.pop_front();
+		}
 
-	return true;
+		// surfaces belong to no renderer, so decoding and converting them is safe off the main thread
+		auto surface = Config::MakeResource(LoadImage(request.fileName, request.atlas.get()));
+		if (surface != nullptr && request.format != SDL_PIXELFORMAT_UNKNOWN && surface->format->format != request.format)
+		{
+			if (auto converted = Config::MakeResource(SDL_ConvertSurfaceFormat(surface.get(), request.format, 0)); converted != nullptr)
+			{
+				surface = std::move(converted);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_decodeMutex);
+			m_decodedImages.push_back({ request.handle, request.generation, std::move(surface) });
+		}
+		m_decodedCondition.notify_all();
+	}
 }
 
 void TextureManager::Draw(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
-	SDL_Rect src_rect{};
-	SDL_Rect dest_rect{};
+	Draw(m_textures.Find(id), x, y, angle, alpha, centered, flip);
+}
 
-	src_rect.x = 0;
-	src_rect.y = 0;
+void TextureManager::Draw(const std::string& id, const glm::vec2 position, const double angle, const int alpha, const bool centered,
+                          const SDL_RendererFlip flip)
+{
+	Draw(m_textures.Find(id), static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
+}
 
-	int texture_width;
-	int texture_height;
+void TextureManager::Draw(const std::string& id, const int x, const int y, const GameObject* go, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	Draw(m_textures.Find(id), x, y, go, angle, alpha, centered, flip);
+}
 
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
+void TextureManager::Draw(const TextureHandle handle, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	bool is_placeholder;
+	const auto texture = GetDrawTexture(handle, is_placeholder);
+	if (texture == nullptr)
+	{
+		return;
+	}
+	const auto& entry = m_textures.Get(handle);
 
-	src_rect.w = dest_rect.w = texture_width;
-	src_rect.h = dest_rect.h = texture_height;
+	SDL_Rect src_rect{};
+	SDL_Rect dest_rect{};
+
+	src_rect.x = entry.x;
+	src_rect.y = entry.y;
+
+	src_rect.w = dest_rect.w = entry.width > 0 ? entry.width : PLACEHOLDER_SIZE;
+	src_rect.h = dest_rect.h = entry.height > 0 ? entry.height : PLACEHOLDER_SIZE;
 
 	if (centered) {
-		const auto x_offset = static_cast<int>(texture_width * 0.5);
-		const auto y_offset = static_cast<int>(texture_height * 0.5);
+		// the size drawn, so a placeholder is centered on the same point the texture will be
+		const auto x_offset = static_cast<int>(dest_rect.w * 0.5);
+		const auto y_offset = static_cast<int>(dest_rect.h * 0.5);
 		dest_rect.x = x - x_offset;
 		dest_rect.y = y - y_offset;
 	}
@@ -139,24 +521,31 @@ void TextureManager::Draw(const std::string & id, const int x, const int y, cons
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	ApplyColour(texture, entry);
+	SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha));
+	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), texture, is_placeholder ? nullptr : &src_rect, &dest_rect, angle, nullptr, flip);
 }
 
-void TextureManager::Draw(const std::string& id, const glm::vec2 position, const double angle, const int alpha, const bool centered,
+void TextureManager::Draw(const TextureHandle handle, const glm::vec2 position, const double angle, const int alpha, const bool centered,
                           const SDL_RendererFlip flip)
 {
-	Draw(id, static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
+	Draw(handle, static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
 }
 
-void TextureManager::Draw(const std::string& id, const int x, const int y, const GameObject* go, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+void TextureManager::Draw(const TextureHandle handle, const int x, const int y, const GameObject* go, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	bool is_placeholder;
+	const auto texture = GetDrawTexture(handle, is_placeholder);
+	if (texture == nullptr)
+	{
+		return;
+	}
+	const auto& entry = m_textures.Get(handle);
+
 	SDL_Rect src_rect{};
 	SDL_Rect dest_rect{};
 
-	int texture_width, texture_height;
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
-	src_rect = { 0, 0, texture_width, texture_height };
+	src_rect = { entry.x, entry.y, entry.width, entry.height };
 	dest_rect.w = go->GetWidth();
 	dest_rect.h = go->GetHeight();
 
@@ -171,8 +560,9 @@ void TextureManager::Draw(const std::string& id, const int x, const int y, const
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	ApplyColour(texture, entry);
+	SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha));
+	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), texture, is_placeholder ? nullptr : &src_rect, &dest_rect, angle, nullptr, flip);
 }
 
 void TextureManager::DrawFrame(const std::string & id, const int x, const int y, const int frame_width,
@@ -181,7 +571,25 @@ void TextureManager::DrawFrame(const std::string & id, const int x, const int y,
                                const float speed_factor, const double angle,
                                const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	DrawFrame(m_textures.Find(id), x, y, frame_width, frame_height, current_row, current_frame, frame_number, row_number,
+		speed_factor, angle, alpha, centered, flip);
+}
+
+void TextureManager::DrawFrame(const TextureHandle handle, const int x, const int y, const int frame_width,
+                               const int frame_height, int& current_row,
+                               int& current_frame, const int frame_number, const int row_number,
+                               const float speed_factor, const double angle,
+                               const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	bool is_placeholder;
+	const auto texture = GetDrawTexture(handle, is_placeholder);
+	if (texture == nullptr)
+	{
+		return;
+	}
+
 	AnimateFrames(frame_width, frame_height, frame_number, row_number, speed_factor, current_frame, current_row);
+	const auto& entry = m_textures.Get(handle);
 
 	SDL_Rect src_rect{};
 	SDL_Rect dest_rect{};
@@ -194,8 +602,8 @@ void TextureManager::DrawFrame(const std::string & id, const int x, const int y,
 	const auto texture_height = frame_height;
 
 	// starting point of the where we are looking
-	src_rect.x = texture_width * current_frame;
-	src_rect.y = texture_height * current_row;
+	src_rect.x = entry.x + texture_width * current_frame;
+	src_rect.y = entry.y + texture_height * current_row;
 
 	src_rect.w = texture_width;
 	src_rect.h = texture_height;
@@ -214,8 +622,9 @@ void TextureManager::DrawFrame(const std::string & id, const int x, const int y,
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	ApplyColour(texture, entry);
+	SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha));
+	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), texture, is_placeholder ? nullptr : &src_rect, &dest_rect, angle, nullptr, flip);
 }
 
 void TextureManager::AnimateFrames(int frame_width, int frame_height, const int frame_number, const int row_number, const float speed_factor, int& current_frame, int& current_row) const
@@ -243,44 +652,22 @@ void TextureManager::AnimateFrames(int frame_width, int frame_height, const int
 }
 
 void TextureManager::PlayAnimation(
-	const std::string & sprite_sheet_name, Animation & animation,
-	const int x, const int y, const float speed_factor,
-	const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+	const TextureHandle sprite_sheet, const AnimatorHandle animator,
+	const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
-	const auto total_frames = static_cast<float>(animation.frames.size());
-	const int animation_rate = static_cast<int>(round(total_frames / 2.0f / speed_factor));
-
-	if (total_frames > 1)
+	bool is_placeholder;
+	const auto texture = GetDrawTexture(sprite_sheet, is_placeholder);
+	const auto frame_rect = AnimationManager::Instance().GetFrameRect(animator);
+	if (texture == nullptr || frame_rect == nullptr)
 	{
-		if (Game::Instance().GetFrames() % animation_rate == 0)
-		{
-			animation.current_frame++;
-			if (static_cast<float>(animation.current_frame) > total_frames - 1)
-			{
-				animation.current_frame = 0;
-			}
-		}
+		return;
 	}
+	const auto& entry = m_textures.Get(sprite_sheet);
 
-	SDL_Rect src_rect{};
+	const SDL_Rect src_rect{ entry.x + frame_rect->x, entry.y + frame_rect->y, frame_rect->w, frame_rect->h };
 	SDL_Rect dest_rect{};
-
-	src_rect.x = 0;
-	src_rect.y = 0;
-
-	// frame_height size
-	const auto texture_width = animation.frames[animation.current_frame].w;
-	const auto texture_height = animation.frames[animation.current_frame].h;
-
-	// starting point of the where we are looking
-	src_rect.x = animation.frames[animation.current_frame].x;
-	src_rect.y = animation.frames[animation.current_frame].y;
-
-	src_rect.w = animation.frames[animation.current_frame].w;
-	src_rect.h = animation.frames[animation.current_frame].h;
-
-	dest_rect.w = texture_width;
-	dest_rect.h = texture_height;
+	dest_rect.w = src_rect.w;
+	dest_rect.h = src_rect.h;
 
 	if (centered) {
 		const int x_offset = static_cast<int>(dest_rect.w * 0.5);
@@ -293,108 +680,328 @@ void TextureManager::PlayAnimation(
 		dest_rect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[sprite_sheet_name].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[sprite_sheet_name].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	ApplyColour(texture, entry);
+	SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(alpha));
+	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), texture, is_placeholder ? nullptr : &src_rect, &dest_rect, angle, nullptr, flip);
 }
-
-void TextureManager::PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, const glm::vec2 position,
-	const float speed_factor, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+void TextureManager::PlayAnimation(const TextureHandle sprite_sheet, const AnimatorHandle animator, const glm::vec2 position,
+	const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
-	PlayAnimation(sprite_sheet_name, animation, static_cast<int>(position.x), static_cast<int>(position.y), speed_factor, angle, alpha, centered, flip);
+	PlayAnimation(sprite_sheet, animator, static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
 }
 
 void TextureManager::DrawText(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
-	SDL_Rect src_rect{};
-	SDL_Rect dest_rect{};
-
-	src_rect.x = 0;
-	src_rect.y = 0;
-
-	int texture_width;
-	int texture_height;
-
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &texture_width, &texture_height);
-
-	src_rect.w = dest_rect.w = texture_width;
-	src_rect.h = dest_rect.h = texture_height;
-
-	if (centered) {
-		const int x_offset = static_cast<int>(dest_rect.w * 0.5);
-		const int y_offset = static_cast<int>(dest_rect.h * 0.5);
-		dest_rect.x = x - x_offset;
-		dest_rect.y = y - y_offset;
-	}
-	else {
-		dest_rect.x = x;
-		dest_rect.y = y;
-	}
-
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), static_cast<Uint8>(alpha));
-	SDL_RenderCopyEx(Renderer::Instance().GetRenderer(), m_textureMap[id].get(), &src_rect, &dest_rect, angle, nullptr, flip);
+	// text is drawn at its natural size, the same as any other texture
+	Draw(m_textures.Find(id), x, y, angle, alpha, centered, flip);
 }
 
 void TextureManager::DrawText(const std::string& id, const glm::vec2 position, const double angle, const int alpha, const bool centered,
                               const SDL_RendererFlip flip)
 {
-	DrawText(id, static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
+	Draw(m_textures.Find(id), static_cast<int>(position.x), static_cast<int>(position.y), angle, alpha, centered, flip);
 }
 
 glm::vec2 TextureManager::GetTextureSize(const std::string & id)
 {
-	int width;
-	int height;
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &width, &height);
+	return GetTextureSize(m_textures.Find(id));
+}
+
+glm::vec2 TextureManager::GetTextureSize(const TextureHandle handle) const
+{
+	if (!m_textures.IsLoaded(handle) && !IsPending(handle))
+	{
+		return { 0.0f, 0.0f };
+	}
 
-	return { static_cast<float>(width), static_cast<float>(height) };
+	const auto& entry = m_textures.Get(handle);
+	return { static_cast<float>(entry.width), static_cast<float>(entry.height) };
 }
 
 void TextureManager::SetAlpha(const std::string & id, const Uint8 new_alpha)
 {
-	std::shared_ptr<SDL_Texture> texture = m_textureMap[id];
-	SDL_SetTextureAlphaMod(texture.get(), new_alpha);
-	texture = nullptr;
+	SDL_SetTextureAlphaMod(GetTexture(id), new_alpha);
 }
 
 void TextureManager::SetColour(const std::string & id, const Uint8 red, const Uint8 green, const Uint8 blue)
 {
-	std::shared_ptr<SDL_Texture> texture = m_textureMap[id];
-	SDL_SetTextureColorMod(texture.get(), red, green, blue);
-	texture = nullptr;
+	const auto handle = m_textures.Find(id);
+	if (!m_textures.IsLoaded(handle))
+	{
+		return;
+	}
+
+	// a page is shared, so a packed image keeps its colour to itself and has it set when it is drawn
+	auto& entry = m_textures.Get(handle);
+	entry.colour = { red, green, blue, 255 };
+	if (!entry.packed)
+	{
+		SDL_SetTextureColorMod(entry.texture.get(), red, green, blue);
+	}
 }
 
 bool TextureManager::AddTexture(const std::string & id, std::shared_ptr<SDL_Texture> texture)
 {
-	if (TextureExists(id))
+	return AddTexture(m_textures.Intern(id), std::move(texture));
+}
+
+bool TextureManager::AddTexture(const TextureHandle handle, std::shared_ptr<SDL_Texture> texture)
+{
+	if (m_textures.IsLoaded(handle))
 	{
 		return true;
 	}
 
-	m_textureMap[id] = std::move(texture);
+	if (texture != nullptr)
+	{
+		StoreTexture(handle, std::move(texture));
+	}
 
 	return true;
 }
 
 SDL_Texture* TextureManager::GetTexture(const std::string & id)
 {
-	return m_textureMap[id].get();
+	return GetTexture(m_textures.Find(id));
+}
+
+SDL_Texture* TextureManager::GetTexture(const TextureHandle handle)
+{
+	if (!m_textures.IsLoaded(handle))
+	{
+		return nullptr;
+	}
+
+	const auto& entry = m_textures.Get(handle);
+	return entry.packed ? entry.source.get() : entry.texture.get();
 }
 
 void TextureManager::RemoveTexture(const std::string & id)
 {
-	m_textureMap.erase(id);
+	// the handle stays reserved for the id, so objects holding it pick up a reload
+	const auto handle = m_textures.Find(id);
+	if (handle.IsValid())
+	{
+		m_textures.Reset(handle);
+	}
+}
+
+int TextureManager::PackTextures()
+{
+	const auto renderer = Renderer::Instance().GetRenderer();
+	if (renderer == nullptr || !SDL_RenderTargetSupported(renderer))
+	{
+		return 0;
+	}
+
+	auto page_size = PAGE_SIZE;
+	if (SDL_RendererInfo info; SDL_GetRendererInfo(renderer, &info) == 0)
+	{
+		if (info.max_texture_width > 0)
+		{
+			page_size = std::min(page_size, info.max_texture_width);
+		}
+		if (info.max_texture_height > 0)
+		{
+			page_size = std::min(page_size, info.max_texture_height);
+		}
+	}
+	const auto max_packed_size = std::min(MAX_PACKED_SIZE, page_size);
+
+	std::vector<TextureHandle> candidates;
+	for (uint32_t index = 0; index < m_textures.GetSlotCount(); ++index)
+	{
+		const TextureHandle handle{ index };
+		if (!m_textures.IsLoaded(handle))
+		{
+			continue;
+		}
+
+		// a sprite sheet hands its texture out as a whole to whoever draws from it
+		auto& entry = m_textures.Get(handle);
+		const auto& source = entry.packed ? entry.source : entry.texture;
+		bool can_pack = source != nullptr && entry.width > 0 && entry.height > 0 &&
+			entry.width <= max_packed_size && entry.height <= max_packed_size &&
+			m_spriteSheetMap.find(m_textures.GetName(handle)) == m_spriteSheetMap.end();
+
+		// whoever owns a streaming or target texture may change its pixels, a copy would go stale
+		int access = SDL_TEXTUREACCESS_STATIC;
+		can_pack = can_pack && SDL_QueryTexture(source.get(), nullptr, &access, nullptr, nullptr) == 0 && access == SDL_TEXTUREACCESS_STATIC;
+
+		if (can_pack)
+		{
+			candidates.push_back(handle);
+		}
+		else if (entry.packed)
+		{
+			// no longer fits the new pages, draw it from its own texture again
+			entry.texture = std::move(entry.source);
+			entry.x = 0;
+			entry.y = 0;
+			entry.packed = false;
+			SDL_SetTextureColorMod(entry.texture.get(), entry.colour.r, entry.colour.g, entry.colour.b);
+		}
+	}
+
+	// tallest first keeps the skyline flat
+	std::sort(candidates.begin(), candidates.end(), [this](const TextureHandle lhs, const TextureHandle rhs)
+	{
+		const auto& lhs_entry = m_textures.Get(lhs);
+		const auto& rhs_entry = m_textures.Get(rhs);
+		return lhs_entry.height != rhs_entry.height ? lhs_entry.height > rhs_entry.height : lhs_entry.width > rhs_entry.width;
+	});
+
+	std::vector<SkylinePacker> packers;
+	std::vector<std::pair<size_t, SDL_Rect>> placements;
+	placements.reserve(candidates.size());
+	for (const auto handle : candidates)
+	{
+		const auto& entry = m_textures.Get(handle);
+		SDL_Rect placed{};
+		auto page = packers.size();
+		for (size_t i = 0; i < packers.size(); ++i)
+		{
+			if (packers[i].Insert(entry.width, entry.height, placed))
+			{
+				page = i;
+				break;
+			}
+		}
+		if (page == packers.size())
+		{
+			packers.emplace_back(page_size, page_size, PAGE_PADDING);
+			packers.back().Insert(entry.width, entry.height, placed);
+		}
+		placements.emplace_back(page, placed);
+	}
+
+	const auto format = GetNativeFormat() != SDL_PIXELFORMAT_UNKNOWN ? GetNativeFormat() : static_cast<Uint32>(SDL_PIXELFORMAT_ARGB8888);
+	std::vector<std::shared_ptr<SDL_Texture>> pages;
+	for (const auto& packer : packers)
+	{
+		auto page = Config::MakeResource(SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, packer.GetWidth(), packer.GetHeight()));
+		if (page == nullptr)
+		{
+			std::cout << "error creating texture page: " << SDL_GetError() << std::endl;
+			return m_pageCount;
+		}
+		SDL_SetTextureBlendMode(page.get(), SDL_BLENDMODE_BLEND);
+		pages.push_back(std::move(page));
+	}
+
+	// the copies are made on the GPU, nothing is read back
+	const auto previous_target = SDL_GetRenderTarget(renderer);
+	Uint8 red, green, blue, alpha;
+	SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+	for (const auto& page : pages)
+	{
+		SDL_SetRenderTarget(renderer, page.get());
+		SDL_RenderClear(renderer);
+	}
+
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		const auto& entry = m_textures.Get(candidates[i]);
+		const auto& [page, placed] = placements[i];
+		const auto source = entry.packed ? entry.source.get() : entry.texture.get();
+
+		// copied as is, alpha included, whatever the source's own draw settings are
+		SDL_BlendMode blend_mode;
+		SDL_GetTextureBlendMode(source, &blend_mode);
+		SDL_SetTextureBlendMode(source, SDL_BLENDMODE_NONE);
+		SDL_SetTextureAlphaMod(source, 255);
+		SDL_SetTextureColorMod(source, 255, 255, 255);
+
+		SDL_SetRenderTarget(renderer, pages[page].get());
+		SDL_RenderCopy(renderer, source, nullptr, &placed);
+
+		SDL_SetTextureBlendMode(source, blend_mode);
+	}
+
+	SDL_SetRenderTarget(renderer, previous_target);
+	SDL_SetRenderDrawColor(renderer, red, green, blue, alpha);
+
+	// SetColour already keeps its colour in the entry, the old pages go with their last entry
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		auto& entry = m_textures.Get(candidates[i]);
+		const auto& [page, placed] = placements[i];
+		if (!entry.packed)
+		{
+			entry.source = std::move(entry.texture);
+		}
+		entry.texture = pages[page];
+		entry.x = placed.x;
+		entry.y = placed.y;
+		entry.packed = true;
+	}
+
+	m_pageCount = static_cast<int>(pages.size());
+	std::cout << "packed " << candidates.size() << " textures into " << m_pageCount << " pages" << std::endl;
+	return m_pageCount;
+}
+
+int TextureManager::GetPageCount() const
+{
+	return m_pageCount;
 }
 
 int TextureManager::GetTextureMapSize() const
 {
-	return static_cast<int>(m_textureMap.size());
+	return m_textures.GetLoadedCount();
+}
+
+void TextureManager::AddReference(const TextureHandle handle)
+{
+	m_textures.AddReference(handle);
+}
+
+void TextureManager::RemoveReference(const TextureHandle handle)
+{
+	m_textures.RemoveReference(handle);
+}
+
+void TextureManager::CleanUnreferenced()
+{
+	for (uint32_t index = 0; index < m_textures.GetSlotCount(); ++index)
+	{
+		const TextureHandle handle{ index };
+		if (!m_textures.IsLoaded(handle) || m_textures.GetReferenceCount(handle) > 0)
+		{
+			continue;
+		}
+
+		// a sprite sheet shares its texture's name and would be left pointing at a destroyed texture
+		if (const auto it = m_spriteSheetMap.find(m_textures.GetName(handle)); it != m_spriteSheetMap.end())
+		{
+			delete it->second;
+			m_spriteSheetMap.erase(it);
+		}
+		m_textures.Reset(handle);
+	}
+	std::cout << "Unreferenced textures cleared,  TextureMap Size: " << m_textures.GetLoadedCount() << std::endl;
 }
 
 void TextureManager::Clean()
 {
-	m_textureMap.clear();
-	std::cout << "TextureMap Cleared,  TextureMap Size: " << m_textureMap.size() << std::endl;
+	// pending loads are dropped with everything else, their images are ignored when they arrive
+	++m_loadGeneration;
+	m_pendingLoadCount = 0;
+	m_uploads.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_decodeMutex);
+		m_decodeRequests.clear();
+	}
 
+	m_textures.ResetAll();
+	m_pageCount = 0;
+	std::cout << "TextureMap Cleared,  TextureMap Size: " << m_textures.GetLoadedCount() << std::endl;
+
+	for (const auto& sprite_sheet : m_spriteSheetMap)
+	{
+		delete sprite_sheet.second;
+	}
 	m_spriteSheetMap.clear();
 	std::cout << "Existing SpriteSheets Cleared" << std::endl;
 }
@@ -402,17 +1009,19 @@ void TextureManager::Clean()
 void TextureManager::DisplayTextureMap()
 {
 	std::cout << "------------ Displaying Texture Map -----------" << std::endl;
-	std::cout << "Texture Map size: " << m_textureMap.size() << std::endl;
-	auto it = m_textureMap.begin();
-	while (it != m_textureMap.end())
+	std::cout << "Texture Map size: " << m_textures.GetLoadedCount() << std::endl;
+	for (uint32_t index = 0; index < m_textures.GetSlotCount(); ++index)
 	{
-		std::cout << it->first << std::endl;
-		++it;
+		if (m_textures.IsLoaded(TextureHandle{ index }))
+		{
+			std::cout << m_textures.GetName(TextureHandle{ index }) << std::endl;
+		}
 	}
 }
 
 SpriteSheet* TextureManager::GetSpriteSheet(const std::string & name)
 {
-	return m_spriteSheetMap[name];
+	const auto it = m_spriteSheetMap.find(name);
+	return it != m_spriteSheetMap.end() ? it->second : nullptr;
 }
 
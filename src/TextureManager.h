@@ -3,18 +3,26 @@
 #define __TEXTURE_MANAGER__
 
 // Core Libraries
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "glm/vec2.hpp"
 
 // SDL Libraries
 #include<SDL.h>
 
+#include "AssetRegistry.h"
 #include "Config.h"
+#include "SpriteAtlas.h"
 #include "SpriteSheet.h"
-#include "Animation.h"
+#include "Frame.h"
+#include "AnimationManager.h"
 #include "GameObject.h"
 
 /* Singleton */
@@ -27,38 +35,112 @@ public:
 		return instance;
 	}
 
+	/*
+	 * Handle for a texture id, valid whether or not the texture has been loaded yet. Look it up once and
+	 * keep it, the handle overloads below skip the name lookup entirely
+	 */
+	TextureHandle GetTextureHandle(AssetName id);
+
 	// loading functions
 	bool Load(const std::string& file_name, const std::string& id);
 	bool LoadSpriteSheet(const std::string& data_file_name, const std::string& texture_file_name, const std::string& sprite_sheet_name);
 
-	// drawing functions
+	/*
+	 * The main thread half of a load whose decoding was done elsewhere, such as by the AssetLoader. Only
+	 * creating the texture from the surface happens here, and nothing at all if the texture is already loaded
+	 */
+	bool AddSurface(TextureHandle handle, const std::shared_ptr<SDL_Surface>& surface);
+	// the sheet takes the texture named sprite_sheet_name, now if it is loaded or once it is uploaded
+	bool AddSpriteSheet(const std::string& sprite_sheet_name, std::shared_ptr<const SpriteAtlas> atlas);
+
+	/*
+	 * Queues the image to be decoded on the worker threads and returns its handle straight away. The
+	 * decoded image is converted to the renderer's own pixel format on the worker, so turning it into a
+	 * texture in UploadPendingTextures is a plain copy. Until then the handle draws a placeholder
+	 */
+	TextureHandle LoadAsync(const std::string& file_name, const std::string& id);
+	/*
+	 * The atlas is mapped straight away so GetSpriteSheet works at once, only the image is decoded in the
+	 * background. An image embedded in the atlas wins over texture_file_name, which wins over the name in the atlas
+	 */
+	TextureHandle LoadSpriteSheetAsync(const std::string& data_file_name, const std::string& texture_file_name, const std::string& sprite_sheet_name);
+
+	[[nodiscard]] bool IsLoaded(TextureHandle handle) const;
+	// true from LoadAsync until the texture is uploaded or its image failed to load
+	[[nodiscard]] bool IsPending(TextureHandle handle) const;
+	[[nodiscard]] int GetPendingLoadCount() const;
+
+	// called by the game once a frame, creates at most GetUploadBudget textures from images the workers have decoded
+	void UploadPendingTextures();
+	// blocks until every pending load has been decoded and uploads them all, whatever the budget
+	void FinishPendingLoads();
+	void SetUploadBudget(int max_uploads);
+	[[nodiscard]] int GetUploadBudget() const;
+	// number of decode threads, takes effect the next time the workers start
+	void SetDecodeWorkerCount(int count);
+	// stops and joins the decode workers and drops every pending load
+	void Shutdown();
+
+	// drawing functions, drawing a texture that isn't loaded does nothing, or draws the placeholder while it is pending
+	void Draw(TextureHandle handle, int x, int y, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void Draw(TextureHandle handle, glm::vec2 position, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void Draw(TextureHandle handle, int x, int y, const GameObject* go, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void Draw(const std::string& id, int x, int y, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void Draw(const std::string& id, glm::vec2 position, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void Draw(const std::string& id, int x, int y, const GameObject* go, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void DrawFrame(const std::string& id, int x, int y, int frame_width, int frame_height,
 		int& current_row, int& current_frame, int frame_number, int row_number, float speed_factor,
 		double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void DrawFrame(TextureHandle handle, int x, int y, int frame_width, int frame_height,
+		int& current_row, int& current_frame, int frame_number, int row_number, float speed_factor,
+		double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void DrawText(const std::string& id, int x, int y, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void DrawText(const std::string& id, glm::vec2 position, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	// animation functions
 	void AnimateFrames(int frame_width, int frame_height, int frame_number, int row_number, float speed_factor, int& current_frame, int& current_row) const;
-	void PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, int x, int y, float speed_factor, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
-	void PlayAnimation(const std::string& sprite_sheet_name, Animation& animation, glm::vec2 position, float speed_factor, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	// draws the animator's current frame, the AnimationManager advances it so drawing changes nothing
+	void PlayAnimation(TextureHandle sprite_sheet, AnimatorHandle animator, int x, int y, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void PlayAnimation(TextureHandle sprite_sheet, AnimatorHandle animator, glm::vec2 position, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	SpriteSheet* GetSpriteSheet(const std::string& name);
 
-	// texture utility functions
+	// texture utility functions, a packed texture returns the texture it was loaded as rather than its page
 	SDL_Texture* GetTexture(const std::string& id);
+	SDL_Texture* GetTexture(TextureHandle handle);
 	void SetColour(const std::string& id, Uint8 red, Uint8 green, Uint8 blue);
 	bool AddTexture(const std::string& id, std::shared_ptr<SDL_Texture> texture);
+	bool AddTexture(TextureHandle handle, std::shared_ptr<SDL_Texture> texture);
 	void RemoveTexture(const std::string& id);
 	glm::vec2 GetTextureSize(const std::string& id);
+	// cached when the texture is loaded, or as soon as a pending image is decoded, zero until then
+	[[nodiscard]] glm::vec2 GetTextureSize(TextureHandle handle) const;
 	void SetAlpha(const std::string& id, Uint8 new_alpha);
 
+	/*
+	 * Copies every loaded texture no bigger than MAX_PACKED_SIZE into shared pages and points its id at
+	 * its part of a page. Drawing a scene then switches textures a handful of times at most, which lets the
+	 * renderer batch the draws. Ids, handles and sizes stay the same, so nothing that draws has to change.
+	 * Pages are rebuilt from scratch every call, so space left by unloaded textures is reclaimed. Sprite
+	 * sheets and textures that aren't static, such as render targets, are left alone.
+	 * The pages are render targets, which the renderer may wipe, so every packed texture keeps the texture
+	 * it was loaded as to pack from again. The EventManager calls this on SDL_RENDER_TARGETS_RESET. An
+	 * SDL_RENDER_DEVICE_RESET loses every texture, the kept ones included, and is not handled: nothing in
+	 * the engine reloads textures from disk. Returns the number of pages, 0 when the renderer can't render
+	 * to textures
+	 */
+	int PackTextures();
+	[[nodiscard]] int GetPageCount() const;
+
 	// textureMap functions
 	[[nodiscard]] int GetTextureMapSize() const;
 	void DisplayTextureMap();
 	void Clean();
 
+	// asset manifests hold a reference to every texture they list so a scene change keeps shared ones loaded
+	void AddReference(TextureHandle handle);
+	void RemoveReference(TextureHandle handle);
+	// unloads every texture nothing holds a reference to, along with its sprite sheet
+	void CleanUnreferenced();
+
 
 private:
 
@@ -69,9 +151,81 @@ private:
 	bool TextureExists(const std::string& id);
 	bool SpriteSheetExists(const std::string& sprite_sheet_name);
 
+	struct TextureEntry
+	{
+		std::shared_ptr<SDL_Texture> texture;
+		int width = 0;
+		int height = 0;
+		// waiting on an asynchronous load, the texture is still null
+		bool pending = false;
+		// where the image sits in texture, which is a page shared with other images once it is packed
+		int x = 0;
+		int y = 0;
+		bool packed = false;
+		// the texture the image was loaded as, kept while packed so the pages can be built again
+		std::shared_ptr<SDL_Texture> source;
+		// SetColour tints the image alone, a page applies it for each draw
+		SDL_Color colour{ 255, 255, 255, 255 };
+	};
+
+	struct DecodeRequest
+	{
+		TextureHandle handle;
+		uint32_t generation;
+		Uint32 format;
+		std::string fileName;
+		// decoded from the atlas instead of fileName when it embeds the image
+		std::shared_ptr<const SpriteAtlas> atlas;
+	};
+
+	struct DecodedImage
+	{
+		TextureHandle handle;
+		uint32_t generation;
+		std::shared_ptr<SDL_Surface> surface;
+	};
+
+	void StoreTexture(TextureHandle handle, std::shared_ptr<SDL_Texture> texture);
+
+	// the texture a draw uses: the handle's own once loaded, the placeholder while it is pending, otherwise null
+	SDL_Texture* GetDrawTexture(TextureHandle handle, bool& is_placeholder);
+	SDL_Texture* GetPlaceholder();
+	Uint32 GetNativeFormat();
+
+	// the page draws the entry's colour, a texture of its own has it set already
+	void ApplyColour(SDL_Texture* texture, const TextureEntry& entry) const;
+
+	void QueueDecode(TextureHandle handle, const std::string& file_name, std::shared_ptr<const SpriteAtlas> atlas);
+
+	void CollectDecodedImages();
+	void UploadDecodedImage(const DecodedImage& image);
+	void StartDecodeWorkers();
+	void DecodeLoop();
+
 	// storage structures
-	std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> m_textureMap;
+	AssetRegistry<TextureTag, TextureEntry> m_textures;
 	std::unordered_map<std::string, SpriteSheet*> m_spriteSheetMap;
+	// pages live as long as a packed entry holds them, this only counts the last PackTextures
+	int m_pageCount = 0;
+
+	// asynchronous loading, main thread only
+	std::deque<DecodedImage> m_uploads;
+	std::shared_ptr<SDL_Texture> m_placeholder;
+	// bumped by Clean so images decoded for textures it dropped are ignored
+	uint32_t m_loadGeneration = 0;
+	int m_pendingLoadCount = 0;
+	int m_uploadBudget;
+	int m_decodeWorkerCount;
+	Uint32 m_nativeFormat = SDL_PIXELFORMAT_UNKNOWN;
+
+	std::vector<std::thread> m_decodeWorkers;
+	bool m_decoding = false;
+
+	std::mutex m_decodeMutex;
+	std::condition_variable m_decodeRequestCondition;
+	std::condition_variable m_decodedCondition;
+	std::deque<DecodeRequest> m_decodeRequests;
+	std::deque<DecodedImage> m_decodedImages;
 };
 
 #endif /* defined(__TEXTURE_MANAGER__) */
\ No newline at end of file
@@ -0,0 +1,242 @@
+#include "VisibilityCache.h"
+
+#include <algorithm>
+
+#include "DisplayObject.h"
+
+namespace
+{
+	constexpr int BITS_PER_WORD = 64;
+
+	bool BoxesOverlap(const glm::vec2 a_min, const glm::vec2 a_max, const glm::vec2 b_min, const glm::vec2 b_max)
+	{
+		return a_min.x <= b_max.x && a_max.x >= b_min.x && a_min.y <= b_max.y && a_max.y >= b_min.y;
+	}
+}
+
+VisibilityCache::VisibilityCache() : m_tolerance(Config::TILE_SIZE * 0.5f), m_traceCount(0)
+{
+}
+
+VisibilityCache::~VisibilityCache()
+= default;
+
+int VisibilityCache::AddNode(const glm::vec2 position)
+{
+	m_nodePositions.push_back(position);
+	return static_cast<int>(m_nodePositions.size()) - 1;
+}
+
+void VisibilityCache::SetNodePosition(const int node, const glm::vec2 position)
+{
+	if (m_nodePositions[node] == position)
+	{
+		return;
+	}
+	m_nodePositions[node] = position;
+
+	const auto word = static_cast<size_t>(node / BITS_PER_WORD);
+	const uint64_t bit = uint64_t(1) << (node % BITS_PER_WORD);
+	for (auto& target : m_targets)
+	{
+		if (word < target.valid.size())
+		{
+			target.valid[word] &= ~bit;
+		}
+	}
+}
+
+int VisibilityCache::GetNodeCount() const
+{
+	return static_cast<int>(m_nodePositions.size());
+}
+
+int VisibilityCache::AddTarget(const glm::vec2 position)
+{
+	int target;
+	if (!m_freeTargets.empty())
+	{
+		target = m_freeTargets.back();
+		m_freeTargets.pop_back();
+	}
+	else
+	{
+		target = static_cast<int>(m_targets.size());
+		m_targets.emplace_back();
+	}
+
+	m_targets[target].position = position;
+	m_targets[target].tracedPosition = position;
+	m_targets[target].alive = true;
+	InvalidateTarget(m_targets[target]);
+	return target;
+}
+
+void VisibilityCache::RemoveTarget(const int target)
+{
+	if (!m_targets[target].alive)
+	{
+		return;
+	}
+	m_targets[target].alive = false;
+	InvalidateTarget(m_targets[target]);
+	m_freeTargets.push_back(target);
+}
+
+void VisibilityCache::SetTargetPosition(const int target, const glm::vec2 position)
+{
+	auto& entry = m_targets[target];
+	entry.position = position;
+
+	const auto offset = position - entry.tracedPosition;
+	if (offset.x * offset.x + offset.y * offset.y > m_tolerance * m_tolerance)
+	{
+		entry.tracedPosition = position;
+		InvalidateTarget(entry);
+	}
+}
+
+void VisibilityCache::SetTolerance(const float radius)
+{
+	m_tolerance = std::max(radius, 0.0f);
+}
+
+void VisibilityCache::SyncObstacles(const std::vector<DisplayObject*>& objects)
+{
+	m_nextObstacleBoxes.clear();
+	m_changedBoxes.clear();
+
+	for (const auto object : objects)
+	{
+		if (object == nullptr || object->GetType() != GameObjectType::OBSTACLE)
+		{
+			continue;
+		}
+
+		// centered on their position, the same boxes ObstacleGrid builds
+		const auto half_size = glm::vec2(static_cast<float>(object->GetWidth()), static_cast<float>(object->GetHeight())) * 0.5f;
+		const Box box = { object->GetTransform()->position - half_size, object->GetTransform()->position + half_size };
+		m_nextObstacleBoxes[object->GetEntity()] = box;
+
+		const auto previous = m_obstacleBoxes.find(object->GetEntity());
+		if (previous == m_obstacleBoxes.end())
+		{
+			m_changedBoxes.push_back(box);
+		}
+		else if (previous->second.min != box.min || previous->second.max != box.max)
+		{
+			// both where it was and where it is now may change what a segment hits
+			m_changedBoxes.push_back(previous->second);
+			m_changedBoxes.push_back(box);
+		}
+	}
+
+	for (const auto& [entity, box] : m_obstacleBoxes)
+	{
+		if (m_nextObstacleBoxes.find(entity) == m_nextObstacleBoxes.end())
+		{
+			m_changedBoxes.push_back(box);
+		}
+	}
+
+	std::swap(m_obstacleBoxes, m_nextObstacleBoxes);
+	if (m_changedBoxes.empty())
+	{
+		return;
+	}
+
+	m_obstacleGrid.Build(objects);
+	InvalidateBoxes(m_changedBoxes);
+}
+
+bool VisibilityCache::IsVisible(const int node, const int target)
+{
+	auto& entry = m_targets[target];
+	if (!entry.alive)
+	{
+		return false;
+	}
+
+	const auto word_count = (m_nodePositions.size() + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	if (entry.valid.size() < word_count)
+	{
+		entry.valid.resize(word_count, 0);
+		entry.visible.resize(word_count, 0);
+	}
+
+	const auto word = static_cast<size_t>(node / BITS_PER_WORD);
+	const uint64_t bit = uint64_t(1) << (node % BITS_PER_WORD);
+	if (entry.valid[word] & bit)
+	{
+		return (entry.visible[word] & bit) != 0;
+	}
+
+	++m_traceCount;
+	const bool visible = !m_obstacleGrid.SegmentBlocked(m_nodePositions[node], entry.tracedPosition);
+	entry.valid[word] |= bit;
+	if (visible)
+	{
+		entry.visible[word] |= bit;
+	}
+	else
+	{
+		entry.visible[word] &= ~bit;
+	}
+	return visible;
+}
+
+void VisibilityCache::Clear()
+{
+	m_nodePositions.clear();
+	m_targets.clear();
+	m_freeTargets.clear();
+	m_obstacleBoxes.clear();
+	m_obstacleGrid.Clear();
+	m_traceCount = 0;
+}
+
+int VisibilityCache::GetTraceCount() const
+{
+	return m_traceCount;
+}
+
+void VisibilityCache::InvalidateTarget(Target& target) const
+{
+	std::fill(target.valid.begin(), target.valid.end(), 0);
+}
+
+void VisibilityCache::InvalidateBoxes(const std::vector<Box>& boxes)
+{
+	for (auto& target : m_targets)
+	{
+		if (!target.alive)
+		{
+			continue;
+		}
+
+		for (size_t word = 0; word < target.valid.size(); ++word)
+		{
+			// only entries still valid need their segment box tested
+			for (uint64_t remaining = target.valid[word]; remaining != 0; remaining &= remaining - 1)
+			{
+				int bit_index = 0;
+				while (!(remaining & (uint64_t(1) << bit_index)))
+				{
+					++bit_index;
+				}
+
+				const auto node_position = m_nodePositions[word * BITS_PER_WORD + bit_index];
+				const auto segment_min = glm::vec2(std::min(node_position.x, target.tracedPosition.x), std::min(node_position.y, target.tracedPosition.y));
+				const auto segment_max = glm::vec2(std::max(node_position.x, target.tracedPosition.x), std::max(node_position.y, target.tracedPosition.y));
+				for (const auto& box : boxes)
+				{
+					if (BoxesOverlap(segment_min, segment_max, box.min, box.max))
+					{
+						target.valid[word] &= ~(uint64_t(1) << bit_index);
+						break;
+					}
+				}
+			}
+		}
+	}
+}
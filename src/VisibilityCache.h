@@ -0,0 +1,93 @@
+#pragma once
+#ifndef __VISIBILITY_CACHE__
+#define __VISIBILITY_CACHE__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "ObstacleGrid.h"
+
+class DisplayObject;
+
+/*
+ * Remembers whether each path node can see each target, as a valid bit and a visible bit per pair, so
+ * line of sight is only traced again when something that could change it has moved. An entry is dropped
+ * when an obstacle moves into or out of the box around its segment, when its node moves, or when its
+ * target wanders further than the tolerance from where the entries for it were traced.
+ */
+class VisibilityCache
+{
+public:
+	VisibilityCache();
+	~VisibilityCache();
+
+	int AddNode(glm::vec2 position);
+	void SetNodePosition(int node, glm::vec2 position);
+	[[nodiscard]] int GetNodeCount() const;
+
+	int AddTarget(glm::vec2 position);
+	void RemoveTarget(int target);
+	// entries for the target are kept until it is further than the tolerance from where they were traced
+	void SetTargetPosition(int target, glm::vec2 position);
+	void SetTolerance(float radius);
+
+	/*
+	 * Compares the OBSTACLEs in objects to the last call and drops the entries whose segment box touches an
+	 * obstacle that moved, appeared or went away. Cheap when nothing moved, so call it every frame
+	 */
+	void SyncObstacles(const std::vector<DisplayObject*>& objects);
+
+	// true if nothing blocks the segment from the node to the target, traced only when the entry is stale.
+	// Always false for a removed target
+	bool IsVisible(int node, int target);
+
+	void Clear();
+
+	// segments traced since the cache was created or cleared
+	[[nodiscard]] int GetTraceCount() const;
+
+private:
+	struct Target
+	{
+		glm::vec2 position;
+		// where the cached entries were traced to
+		glm::vec2 tracedPosition;
+		bool alive;
+		std::vector<uint64_t> valid;
+		std::vector<uint64_t> visible;
+	};
+
+	struct Box
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+	};
+
+	void InvalidateTarget(Target& target) const;
+	void InvalidateBoxes(const std::vector<Box>& boxes);
+
+	std::vector<glm::vec2> m_nodePositions;
+	std::vector<Target> m_targets;
+	std::vector<int> m_freeTargets;
+	float m_tolerance;
+
+	ObstacleGrid m_obstacleGrid;
+
+	/*
+	 * Last synced box of each obstacle by entity id rather than pointer, so a deleted obstacle can't be
+	 * confused with a new one allocated at the same address. A recycled id is compared by its box like
+	 * any other obstacle, which invalidates the right entries either way
+	 */
+	std::unordered_map<uint32_t, Box> m_obstacleBoxes;
+
+	// scratch for SyncObstacles
+	std::unordered_map<uint32_t, Box> m_nextObstacleBoxes;
+	std::vector<Box> m_changedBoxes;
+
+	int m_traceCount;
+};
+
+#endif /* defined (__VISIBILITY_CACHE__) */
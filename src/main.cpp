@@ -1,24 +1,35 @@
 // Core Libraries
+#ifdef _WIN32
 #include <crtdbg.h>
+#define NOMINMAX
+#include <Windows.h> //console window
+#endif
 #include <iostream>
-#include <Windows.h>
 #include <SDL.h> //Allows us to use features of SDL Library
 #include <SDL_Image.h> 
 #include <stdio.h>
 #include <string>
 #include <vector> //std::vector is an array with variable size
+#include <unordered_map>
+#include <algorithm> //std::sort
+#include <functional> //std::greater
 #include <random> //needed for random seed
+#include <cstdlib> //std::strtoul
+#include <cstring> //std::strcmp
+#include <cstdint> //uint32_t
 #include <SDL_mixer.h> // for sound and music
 #include <SDL_ttf.h> // for font
 
+#include "SpriteAtlas.h" //packed sprite sheets for --pack-atlas
+
 
 /// <GLOBAL VARIABLES>
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-constexpr float FPS = 60.0f;
-constexpr float DELAY_TIME = 1000.0f / FPS; // target deltaTime in ms
-float deltaTime = 1.0f / FPS; //time passed between frames in secs
+constexpr float FPS = 60.0f; //simulation steps per second
+float deltaTime = 1.0f / FPS; //fixed time simulated by each Update() in secs
+float renderFPS = 60.0f; //frames drawn per second, independent of the simulation rate. 0 draws as fast as possible
 int backgroundX = 0;
 
 //Define screen boundaries
@@ -49,11 +60,35 @@ int highScoreCurrent = 0;
 int characterLives = 3;
 float enemySpawnDelay = 2.0f;
 float enemySpawnTimer = 0.0f;
+float enemyFireRepeatDelay = 3.5f;
+
+//Pool sizes, entities spawned past these limits are dropped
+const int MAX_BULLETS = 4096;
+const int MAX_ENEMIES = 1024;
+
+//Broadphase cell size in pixels, about the size of a scorpion
+const int COLLISION_CELL_SIZE = 128;
 
 //Game state
 bool isGameRunning = true;
 bool isGameOver = false;
 
+//Headless simulation (--headless): no visible window, no drawing and no frame delay, for soak tests and benchmarks
+bool isHeadless = false;
+int headlessFrameCount = 60 * 60; //--frames, simulation steps to run before exiting
+unsigned int randomSeed = 0; //--seed, 0 picks a random one
+std::mt19937 randomGenerator; //every gameplay random number comes from here so a seed reproduces a run
+
+//Input recording (--record file) and replay (--replay file)
+bool isRecording = false;
+bool isReplaying = false;
+const char* recordingFilePath = nullptr;
+
+//Sprite atlas conversion (--pack-atlas text texture output): packs a text atlas for SpriteAtlas::Load and exits
+bool isPackingAtlas = false;
+bool isEmbeddingAtlasImage = false; //--embed, stores the texture inside the packed atlas
+const char* atlasFilePaths[3] = {};
+
 /// <SCORPIO NAMESPACE>
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +100,160 @@ namespace Scorpio
 		float x = 0;
 		float y = 0;
 	};
+	//Flyweight texture registry. Every image file is decoded and uploaded once, sprites only hold a handle into here.
+	//Handles are reference counted so a texture is destroyed once the last sprite using it goes away.
+	class TextureCache
+	{
+	private:
+		struct Entry
+		{
+			std::string filePath; //empty for textures that were not loaded from a file (e.g. rendered text)
+			SDL_Texture* pTexture = nullptr;
+			int width = 0;
+			int height = 0;
+			int refCount = 0;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<int> freeHandles; //slots of released entries that can be reused
+		std::unordered_map<std::string, int> handlesByPath;
+
+		int Store(SDL_Texture* texture, const std::string& filePath)
+		{
+			int handle;
+			if (!freeHandles.empty())
+			{
+				handle = freeHandles.back();
+				freeHandles.pop_back();
+			}
+			else
+			{
+				handle = (int)entries.size();
+				entries.emplace_back();
+			}
+
+			Entry& entry = entries[handle];
+			entry.filePath = filePath;
+			entry.pTexture = texture;
+			entry.refCount = 1;
+			if (SDL_QueryTexture(texture, NULL, NULL, &entry.width, &entry.height) != 0)
+			{
+				std::cout << "Query Texture Failed! " << SDL_GetError() << std::endl;
+			}
+			return handle;
+		}
+
+		bool IsValid(int handle) const
+		{
+			return handle >= 0 && handle < (int)entries.size() && entries[handle].refCount > 0;
+		}
+
+	public:
+		static constexpr int INVALID_HANDLE = -1;
+
+		//Returns a handle to the texture for this file, only touching the disk the first time it is asked for
+		int Acquire(SDL_Renderer* renderer, const char* filePathToLoad)
+		{
+			auto found = handlesByPath.find(filePathToLoad);
+			if (found != handlesByPath.end())
+			{
+				entries[found->second].refCount++;
+				return found->second;
+			}
+
+			SDL_Texture* texture = IMG_LoadTexture(renderer, filePathToLoad);
+			if (texture == NULL)
+			{
+				std::cout << "image failed to load: " << SDL_GetError() << std::endl;
+				return INVALID_HANDLE;
+			}
+			std::cout << "Image load success: " << filePathToLoad << std::endl;
+
+			int handle = Store(texture, filePathToLoad);
+			handlesByPath[filePathToLoad] = handle;
+			return handle;
+		}
+
+		//Takes ownership of a texture that was created elsewhere so it can be shared and released like any other
+		int Adopt(SDL_Texture* texture)
+		{
+			if (texture == NULL)
+			{
+				return INVALID_HANDLE;
+			}
+			return Store(texture, "");
+		}
+
+		void AddRef(int handle)
+		{
+			if (IsValid(handle))
+			{
+				entries[handle].refCount++;
+			}
+		}
+
+		void Release(int handle)
+		{
+			if (!IsValid(handle))
+			{
+				return;
+			}
+
+			Entry& entry = entries[handle];
+			if (--entry.refCount > 0)
+			{
+				return;
+			}
+
+			SDL_DestroyTexture(entry.pTexture);
+			if (!entry.filePath.empty())
+			{
+				handlesByPath.erase(entry.filePath);
+			}
+			entry = Entry();
+			freeHandles.push_back(handle);
+		}
+
+		SDL_Texture* GetTexture(int handle) const
+		{
+			return IsValid(handle) ? entries[handle].pTexture : nullptr;
+		}
+
+		int GetWidth(int handle) const
+		{
+			return IsValid(handle) ? entries[handle].width : 0;
+		}
+
+		int GetHeight(int handle) const
+		{
+			return IsValid(handle) ? entries[handle].height : 0;
+		}
+
+		//Number of live textures, useful to confirm texture memory stays bounded
+		int GetTextureCount() const
+		{
+			return (int)(entries.size() - freeHandles.size());
+		}
+
+		//Destroys every texture regardless of reference counts. Must run before the renderer is destroyed
+		void Clear()
+		{
+			for (Entry& entry : entries)
+			{
+				if (entry.refCount > 0)
+				{
+					SDL_DestroyTexture(entry.pTexture);
+				}
+			}
+			entries.clear();
+			freeHandles.clear();
+			handlesByPath.clear();
+		}
+	};
+
+	//Declared ahead of every sprite so it is destroyed after them
+	TextureCache textureCache;
+
 	//Declaring a struct declares a new type of object we can make
 	//After we can make sprites that contain all the contained data fields and functions
 	struct Sprite
@@ -72,7 +261,7 @@ namespace Scorpio
 
 	private:
 		//Can't be accessed outside the struct or class
-		SDL_Texture* pTexture;
+		int textureHandle = TextureCache::INVALID_HANDLE; //shared texture owned by textureCache
 		SDL_Rect src;
 		SDL_Rect dst;
 		int animationFrameCount = 1;
@@ -82,11 +271,10 @@ namespace Scorpio
 		double rotationDegrees = 0.0;
 		SDL_RendererFlip flipState = SDL_FLIP_NONE;
 		Vec2 position; //where the sprite will draw on the screen
+		Vec2 previousPosition; //position at the start of the current simulation step, used to interpolate drawing
 
 		Sprite()
 		{
-			std::cout << "Sprite Default Constructor!" << std::endl;
-			pTexture = nullptr;
 			src = SDL_Rect{ 0,0,0,0 };
 			dst = SDL_Rect{ 0,0,0,0 };
 		}
@@ -94,39 +282,22 @@ namespace Scorpio
 		Sprite(SDL_Renderer* renderer, TTF_Font* font, const char* text, SDL_Color color) : Sprite()
 		{
 			SDL_Surface* pSurface = TTF_RenderText_Solid(font, text, color);
-			pTexture = SDL_CreateTextureFromSurface(renderer, pSurface);
+			textureHandle = textureCache.Adopt(SDL_CreateTextureFromSurface(renderer, pSurface));
 			SDL_FreeSurface(pSurface);
 			TTF_SizeText(font, text, &src.w, &src.h);
 			dst.w = src.w;
 			dst.h = src.h;
 		}
 
-		Sprite(SDL_Renderer* renderer, const char* filePathToLoad)
+		Sprite(SDL_Renderer* renderer, const char* filePathToLoad) : Sprite()
 		{
-			std::cout << "Sprite Constructor!" << std::endl;
+			//the cache only loads from disk the first time a file is requested
+			textureHandle = textureCache.Acquire(renderer, filePathToLoad);
 
-			pTexture = IMG_LoadTexture(renderer, filePathToLoad);
-			if (pTexture == NULL)
-			{
-				std::cout << "image failed to load: " << SDL_GetError << std::endl;
-			}
-			else
-			{
-				std::cout << "Image load success: " << filePathToLoad << std::endl;
-			}
-			//Query for our images height and width to set a default source rect value spanning the whole texture
-			if (SDL_QueryTexture(pTexture, NULL, NULL, &src.w, &src.h) != 0)
-			{
-				std::cout << "Query Texture Failed!" << SDL_GetError << std::endl;
-			}
-
-			//At this point, SDLQueryTexture has used the addresses for src.w and src.h to place width and height into memory
+			//default source rect spans the whole texture
+			src.w = textureCache.GetWidth(textureHandle);
+			src.h = textureCache.GetHeight(textureHandle);
 
-			src.x = 0;
-			src.y = 0;
-
-			dst.x = 0;
-			dst.y = 0;
 			dst.w = src.w;
 			dst.h = src.h;
 		}
@@ -140,12 +311,77 @@ namespace Scorpio
 			animationFrameCount = numberOfFrames;
 		}
 
+		//Copies share the texture, so they only bump its reference count
+		Sprite(const Sprite& other) :
+			textureHandle(other.textureHandle), src(other.src), dst(other.dst),
+			animationFrameCount(other.animationFrameCount), animationCurrentFrame(other.animationCurrentFrame),
+			rotationDegrees(other.rotationDegrees), flipState(other.flipState), position(other.position),
+			previousPosition(other.previousPosition)
+		{
+			textureCache.AddRef(textureHandle);
+		}
+
+		Sprite& operator=(const Sprite& other)
+		{
+			if (this != &other)
+			{
+				textureCache.AddRef(other.textureHandle);
+				textureCache.Release(textureHandle);
+				textureHandle = other.textureHandle;
+				src = other.src;
+				dst = other.dst;
+				animationFrameCount = other.animationFrameCount;
+				animationCurrentFrame = other.animationCurrentFrame;
+				rotationDegrees = other.rotationDegrees;
+				flipState = other.flipState;
+				position = other.position;
+				previousPosition = other.previousPosition;
+			}
+			return *this;
+		}
+
+		~Sprite()
+		{
+			textureCache.Release(textureHandle);
+		}
+
 		void Draw(SDL_Renderer* renderer)
 		{
 			dst.x = position.x;
 			dst.y = position.y;
 			src.x = (int)animationCurrentFrame * src.w; //find current frame position in source image
-			int result = SDL_RenderCopyEx(renderer, pTexture, &src, &dst, rotationDegrees, NULL, flipState);
+			int result = SDL_RenderCopyEx(renderer, textureCache.GetTexture(textureHandle), &src, &dst, rotationDegrees, NULL, flipState);
+			if (result != 0)
+			{
+				std::cout << "Render Failed! " << SDL_GetError() << std::endl;
+			}
+		}
+
+		//Draws between the previous and current simulation positions. interpolation is 0 at the previous step and 1 at the current one
+		void DrawInterpolated(SDL_Renderer* renderer, float interpolation)
+		{
+			Vec2 simulatedPosition = position;
+			position.x = previousPosition.x + (simulatedPosition.x - previousPosition.x) * interpolation;
+			position.y = previousPosition.y + (simulatedPosition.y - previousPosition.y) * interpolation;
+			Draw(renderer);
+			position = simulatedPosition;
+		}
+
+		//Call at the start of every simulation step so DrawInterpolated knows where the sprite came from
+		void SavePreviousPosition()
+		{
+			previousPosition = position;
+		}
+
+		//Draws this sprite's texture at another position and animation frame, used when one sprite is shared by many entities
+		void DrawFrame(SDL_Renderer* renderer, float x, float y, float frame) const
+		{
+			SDL_Rect frameSrc = src;
+			SDL_Rect frameDst = dst;
+			frameDst.x = x;
+			frameDst.y = y;
+			frameSrc.x = (int)frame * src.w;
+			int result = SDL_RenderCopyEx(renderer, textureCache.GetTexture(textureHandle), &frameSrc, &frameDst, rotationDegrees, NULL, flipState);
 			if (result != 0)
 			{
 				std::cout << "Render Failed! " << SDL_GetError() << std::endl;
@@ -189,7 +425,7 @@ namespace Scorpio
 			SDL_Rect returnValue = dst;
 			returnValue.x = position.x;
 			returnValue.y = position.y;
-			return dst;
+			return returnValue;
 		}
 
 		Vec2 GetSize() const
@@ -198,24 +434,412 @@ namespace Scorpio
 			return returnVec;
 		}
 
+		int GetFrameCount() const
+		{
+			return animationFrameCount;
+		}
+
+		//Drops this sprite's reference, the texture itself is destroyed once nothing else uses it
 		void Cleanup()
 		{
-			SDL_DestroyTexture(pTexture);
+			textureCache.Release(textureHandle);
+			textureHandle = TextureCache::INVALID_HANDLE;
 		}
 
 	}; //struct Sprite
 
-	class Bullet
+	//Text that is rasterised once and only rendered again when its string or colour changes
+	class CachedText
 	{
-	public:
+	private:
 		Sprite sprite;
-		Vec2 velocity;
+		std::string text;
+		SDL_Color textColor = { 0, 0, 0, 0 };
+		bool hasText = false;
 
-		//move bullet
-		void Update()
+	public:
+		void SetText(SDL_Renderer* renderer, TTF_Font* font, const char* newText, SDL_Color color)
 		{
-			sprite.position.x += velocity.x * deltaTime;
-			sprite.position.y += velocity.y * deltaTime;
+			bool isSameColor = textColor.r == color.r && textColor.g == color.g && textColor.b == color.b && textColor.a == color.a;
+			if (hasText && isSameColor && text == newText)
+			{
+				return;
+			}
+
+			text = newText;
+			textColor = color;
+			hasText = true;
+			sprite = Sprite(renderer, font, newText, color);
+		}
+
+		void Draw(SDL_Renderer* renderer, int x, int y, int width, int height)
+		{
+			sprite.SetPosition(x, y);
+			sprite.SetSize(width, height);
+			sprite.Draw(renderer);
+		}
+
+		void Cleanup()
+		{
+			sprite.Cleanup();
+			hasText = false;
+		}
+	};
+
+	//The SYMB_0..9 digit images packed side by side into one texture, so a number is a few copies from a single texture
+	class DigitAtlas
+	{
+	private:
+		static constexpr int DIGIT_COUNT = 10;
+		static constexpr int PADDING = 1; //transparent gap between digits so scaling never bleeds into a neighbour
+
+		int textureHandle = TextureCache::INVALID_HANDLE;
+		SDL_Rect digitRects[DIGIT_COUNT] = {};
+
+	public:
+		//digitPathFormat is a printf format taking the digit, e.g. "../Assets/textures/SYMB_%d.png"
+		bool Load(SDL_Renderer* renderer, const char* digitPathFormat)
+		{
+			SDL_Surface* digitSurfaces[DIGIT_COUNT] = {};
+			int atlasWidth = 0;
+			int atlasHeight = 0;
+			bool success = true;
+
+			for (int digit = 0; digit < DIGIT_COUNT; digit++)
+			{
+				char filePath[256];
+				snprintf(filePath, sizeof(filePath), digitPathFormat, digit);
+				digitSurfaces[digit] = IMG_Load(filePath);
+				if (digitSurfaces[digit] == NULL)
+				{
+					std::cout << "digit image failed to load: " << filePath << " " << SDL_GetError() << std::endl;
+					success = false;
+					continue;
+				}
+
+				digitRects[digit] = { atlasWidth, 0, digitSurfaces[digit]->w, digitSurfaces[digit]->h };
+				atlasWidth += digitSurfaces[digit]->w + PADDING;
+				atlasHeight = std::max(atlasHeight, digitSurfaces[digit]->h);
+			}
+
+			if (success)
+			{
+				//copy every digit, alpha included, into one surface and upload it once
+				SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+				if (atlasSurface == NULL)
+				{
+					std::cout << "digit atlas surface could not be created: " << SDL_GetError() << std::endl;
+					for (SDL_Surface* surface : digitSurfaces)
+					{
+						SDL_FreeSurface(surface);
+					}
+					return false;
+				}
+				for (int digit = 0; digit < DIGIT_COUNT; digit++)
+				{
+					SDL_SetSurfaceBlendMode(digitSurfaces[digit], SDL_BLENDMODE_NONE);
+					SDL_BlitSurface(digitSurfaces[digit], NULL, atlasSurface, &digitRects[digit]);
+				}
+
+				textureCache.Release(textureHandle);
+				textureHandle = textureCache.Adopt(SDL_CreateTextureFromSurface(renderer, atlasSurface));
+				SDL_FreeSurface(atlasSurface);
+				success = textureHandle != TextureCache::INVALID_HANDLE;
+			}
+
+			for (SDL_Surface* surface : digitSurfaces)
+			{
+				SDL_FreeSurface(surface);
+			}
+			return success;
+		}
+
+		//Draws a non-negative number with its top left at x, y. Digits keep their aspect ratio at the given height
+		void DrawNumber(SDL_Renderer* renderer, int value, int x, int y, int height) const
+		{
+			SDL_Texture* texture = textureCache.GetTexture(textureHandle);
+
+			//split into digits, least significant first
+			int digits[12];
+			int digitCount = 0;
+			unsigned int remaining = (unsigned int)std::max(value, 0);
+			do
+			{
+				digits[digitCount++] = remaining % 10;
+				remaining /= 10;
+			} while (remaining > 0);
+
+			for (int i = digitCount - 1; i >= 0; i--)
+			{
+				const SDL_Rect& src = digitRects[digits[i]];
+				SDL_Rect dst = { x, y, src.w * height / std::max(src.h, 1), height };
+				SDL_RenderCopy(renderer, texture, &src, &dst);
+				x += dst.w;
+			}
+		}
+
+		void Cleanup()
+		{
+			textureCache.Release(textureHandle);
+			textureHandle = TextureCache::INVALID_HANDLE;
+		}
+	};
+
+	//Fixed-capacity storage for many entities that all look the same (bullets, enemies).
+	//Each field is its own contiguous array (structure of arrays) so the per-frame passes are tight loops,
+	//and removing an entity moves the last one into its slot instead of shifting the whole container.
+	class EntityPool
+	{
+	public:
+		Sprite sprite; //shared by every entity in the pool, only its texture and size are used
+
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> previousX; //position before the last Integrate, for render interpolation
+		std::vector<float> previousY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> animationFrame;
+		std::vector<float> fireRepeatTimer;
+
+	private:
+		int capacity;
+		int count = 0;
+
+	public:
+		explicit EntityPool(int maxEntities) : capacity(maxEntities)
+		{
+			//allocate everything up front, spawning never allocates
+			positionX.resize(capacity);
+			positionY.resize(capacity);
+			previousX.resize(capacity);
+			previousY.resize(capacity);
+			velocityX.resize(capacity);
+			velocityY.resize(capacity);
+			animationFrame.resize(capacity);
+			fireRepeatTimer.resize(capacity);
+		}
+
+		//Returns the index of the new entity, or -1 if the pool is full
+		int Spawn(Vec2 position, Vec2 velocity)
+		{
+			if (count >= capacity)
+			{
+				return -1;
+			}
+
+			int index = count++;
+			positionX[index] = position.x;
+			positionY[index] = position.y;
+			previousX[index] = position.x;
+			previousY[index] = position.y;
+			velocityX[index] = velocity.x;
+			velocityY[index] = velocity.y;
+			animationFrame[index] = 0.0f;
+			fireRepeatTimer[index] = 0.0f;
+			return index;
+		}
+
+		//Swap-and-pop: the last entity takes this slot, so iterate backwards when removing inside a loop
+		void Remove(int index)
+		{
+			int last = --count;
+			positionX[index] = positionX[last];
+			positionY[index] = positionY[last];
+			previousX[index] = previousX[last];
+			previousY[index] = previousY[last];
+			velocityX[index] = velocityX[last];
+			velocityY[index] = velocityY[last];
+			animationFrame[index] = animationFrame[last];
+			fireRepeatTimer[index] = fireRepeatTimer[last];
+		}
+
+		void Clear()
+		{
+			count = 0;
+		}
+
+		int Count() const
+		{
+			return count;
+		}
+
+		int Capacity() const
+		{
+			return capacity;
+		}
+
+		Vec2 GetPosition(int index) const
+		{
+			return { positionX[index], positionY[index] };
+		}
+
+		SDL_Rect GetRect(int index) const
+		{
+			Vec2 size = sprite.GetSize();
+			return SDL_Rect{ (int)positionX[index], (int)positionY[index], (int)size.x, (int)size.y };
+		}
+
+		//move every entity by its velocity, remembering where it was for interpolation
+		void Integrate(float dt)
+		{
+			float* px = positionX.data();
+			float* py = positionY.data();
+			float* prevX = previousX.data();
+			float* prevY = previousY.data();
+			const float* vx = velocityX.data();
+			const float* vy = velocityY.data();
+			for (int i = 0; i < count; i++)
+			{
+				prevX[i] = px[i];
+				prevY[i] = py[i];
+				px[i] += vx[i] * dt;
+				py[i] += vy[i] * dt;
+			}
+		}
+
+		void AdvanceFrames(float frames)
+		{
+			float frameCount = (float)sprite.GetFrameCount();
+			float* frame = animationFrame.data();
+			for (int i = 0; i < count; i++)
+			{
+				frame[i] += frames;
+				if (frame[i] >= frameCount)
+				{
+					frame[i] = 0;
+				}
+			}
+		}
+
+		void TickFireTimers(float dt)
+		{
+			float* timer = fireRepeatTimer.data();
+			for (int i = 0; i < count; i++)
+			{
+				timer[i] -= dt;
+			}
+		}
+
+		//interpolation is 0 at the previous simulation step and 1 at the current one
+		void Draw(SDL_Renderer* renderer, float interpolation) const
+		{
+			for (int i = 0; i < count; i++)
+			{
+				float x = previousX[i] + (positionX[i] - previousX[i]) * interpolation;
+				float y = previousY[i] + (positionY[i] - previousY[i]) * interpolation;
+				sprite.DrawFrame(renderer, x, y, animationFrame[i]);
+			}
+		}
+	};
+
+	//Uniform grid broadphase, rebuilt every frame from a pool's positions.
+	//Each cell lists the entities overlapping it, packed into one array (cellStart[c] .. cellStart[c + 1]),
+	//so a query only visits the entities in the cells an area touches instead of the whole pool.
+	class SpatialGrid
+	{
+	private:
+		int cellSize;
+		int columns;
+		int rows;
+		std::vector<int> cellStart; //first entry of each cell in cellEntities, plus one past the end
+		std::vector<int> cellCursor; //write position of each cell while building
+		std::vector<int> cellEntities; //entity indices grouped by cell
+		std::vector<uint32_t> queryStamp; //last query that returned each entity, stops entities spanning cells being returned twice
+		uint32_t currentQuery = 0;
+
+		//cells covered by a rect, clamped to the grid so anything past the edges lands in the border cells
+		void GetCellRange(const SDL_Rect& area, int& minColumn, int& minRow, int& maxColumn, int& maxRow) const
+		{
+			minColumn = std::clamp(area.x / cellSize, 0, columns - 1);
+			minRow = std::clamp(area.y / cellSize, 0, rows - 1);
+			maxColumn = std::clamp((area.x + area.w) / cellSize, 0, columns - 1);
+			maxRow = std::clamp((area.y + area.h) / cellSize, 0, rows - 1);
+		}
+
+	public:
+		SpatialGrid(int worldWidth, int worldHeight, int cellSizePx) : cellSize(cellSizePx)
+		{
+			columns = (worldWidth + cellSize - 1) / cellSize;
+			rows = (worldHeight + cellSize - 1) / cellSize;
+			cellStart.resize(columns * rows + 1);
+			cellCursor.resize(columns * rows);
+		}
+
+		void Build(const EntityPool& pool)
+		{
+			std::fill(cellStart.begin(), cellStart.end(), 0);
+			if ((int)queryStamp.size() < pool.Capacity())
+			{
+				queryStamp.resize(pool.Capacity(), 0);
+			}
+
+			//count how many entities touch each cell
+			int minColumn, minRow, maxColumn, maxRow;
+			for (int i = 0; i < pool.Count(); i++)
+			{
+				GetCellRange(pool.GetRect(i), minColumn, minRow, maxColumn, maxRow);
+				for (int row = minRow; row <= maxRow; row++)
+				{
+					for (int column = minColumn; column <= maxColumn; column++)
+					{
+						cellStart[row * columns + column + 1]++;
+					}
+				}
+			}
+
+			//turn the counts into offsets
+			for (int cell = 0; cell < columns * rows; cell++)
+			{
+				cellStart[cell + 1] += cellStart[cell];
+				cellCursor[cell] = cellStart[cell];
+			}
+			cellEntities.resize(cellStart[columns * rows]);
+
+			//write each entity into its cells
+			for (int i = 0; i < pool.Count(); i++)
+			{
+				GetCellRange(pool.GetRect(i), minColumn, minRow, maxColumn, maxRow);
+				for (int row = minRow; row <= maxRow; row++)
+				{
+					for (int column = minColumn; column <= maxColumn; column++)
+					{
+						cellEntities[cellCursor[row * columns + column]++] = i;
+					}
+				}
+			}
+		}
+
+		//Fills results with every entity sharing a cell with the area. These are candidates only, still test them exactly
+		void Query(const SDL_Rect& area, std::vector<int>& results)
+		{
+			results.clear();
+			currentQuery++;
+			if (currentQuery == 0)
+			{
+				//wrapped around, old stamps could match again so they all start over
+				std::fill(queryStamp.begin(), queryStamp.end(), 0);
+				currentQuery = 1;
+			}
+
+			int minColumn, minRow, maxColumn, maxRow;
+			GetCellRange(area, minColumn, minRow, maxColumn, maxRow);
+			for (int row = minRow; row <= maxRow; row++)
+			{
+				for (int column = minColumn; column <= maxColumn; column++)
+				{
+					int cell = row * columns + column;
+					for (int entry = cellStart[cell]; entry < cellStart[cell + 1]; entry++)
+					{
+						int entity = cellEntities[entry];
+						if (queryStamp[entity] != currentQuery)
+						{
+							queryStamp[entity] = currentQuery;
+							results.push_back(entity);
+						}
+					}
+				}
+			}
 		}
 	};
 
@@ -237,35 +861,23 @@ namespace Scorpio
 			sprite.position.y += input.y * (moveSpeedPx * deltaTime);
 		}
 
-		//only handles left and right shooting
-		void Shoot(bool towardRight, std::vector<Bullet>& container, Scorpio::Vec2 velocity)
+		//only handles left and right shooting. The bullet's look comes from the pool's shared sprite
+		void Shoot(bool towardRight, EntityPool& bullets, Scorpio::Vec2 velocity)
 		{
-			//Create a new bullet
-			Scorpio::Sprite bulletSprite;
+			Vec2 bulletPosition;
 			if (towardRight)
 			{
-				bulletSprite = Scorpio::Sprite(pRenderer, "../Assets/textures/playerprojectile.png");
-				bulletSprite.SetSize(125 / 4, 100 / 4);
-				bulletSprite.position.x = sprite.position.x;
-				bulletSprite.position.x += sprite.GetSize().x;
-				bulletSprite.position.y = sprite.position.y + (sprite.GetSize().y * 0.7);
+				bulletPosition.x = sprite.position.x + sprite.GetSize().x;
+				bulletPosition.y = sprite.position.y + (sprite.GetSize().y * 0.7);
 			}
 			else
 			{
-				int width = 50, height = 35, frames = 2;
-				bulletSprite = Scorpio::Sprite(pRenderer, "../Assets/textures/poisonprojectile.png", width, height, frames);
-				bulletSprite.SetSize(125 / 4, 100 / 4);
-				bulletSprite.position.x = sprite.position.x;
-				bulletSprite.position.y = sprite.position.y + ((sprite.GetSize().y * 0.5) + (bulletSprite.GetSize().y * 1.2));
+				bulletPosition.x = sprite.position.x;
+				bulletPosition.y = sprite.position.y + ((sprite.GetSize().y * 0.5) + (bullets.sprite.GetSize().y * 1.2));
 			}
 
-			//set up our bullet class instance
-			Bullet playerBullet;
-			playerBullet.sprite = bulletSprite;
-			playerBullet.velocity = velocity;
-
-			//add bullet to container (to the end of the array)
-			container.push_back(playerBullet);
+			//add bullet to the pool, dropped if the pool is full
+			bullets.Spawn(bulletPosition, velocity);
 
 			//reset cooldown
 			fireRepeatTimer = fireRepeatDelay;
@@ -284,6 +896,122 @@ namespace Scorpio
 
 	}; //character class
 
+	//Bits of one frame of player input, as stored in an input recording
+	enum InputBits : Uint8
+	{
+		INPUT_UP = 1 << 0,
+		INPUT_DOWN = 1 << 1,
+		INPUT_LEFT = 1 << 2,
+		INPUT_RIGHT = 1 << 3,
+		INPUT_SHOOT = 1 << 4,
+		INPUT_SOUND = 1 << 5,
+		INPUT_RESTART = 1 << 6,
+		INPUT_QUIT = 1 << 7
+	};
+
+	//Per-frame input bitmasks plus the random seed of a run, enough to play the run back exactly.
+	//Saved as "SCRP", a version byte, the seed, the frame count and then (bitmask, repeat count) byte pairs
+	class InputRecording
+	{
+	private:
+		static constexpr Uint8 FILE_VERSION = 1;
+
+		std::vector<Uint8> frames;
+		size_t playhead = 0;
+
+	public:
+		unsigned int seed = 0;
+
+		void Add(Uint8 inputBits)
+		{
+			frames.push_back(inputBits);
+		}
+
+		//Gets the next recorded frame, returns false once the recording has run out
+		bool Next(Uint8& inputBits)
+		{
+			if (playhead >= frames.size())
+			{
+				return false;
+			}
+			inputBits = frames[playhead++];
+			return true;
+		}
+
+		size_t FrameCount() const
+		{
+			return frames.size();
+		}
+
+		bool Save(const char* filePath) const
+		{
+			SDL_RWops* file = SDL_RWFromFile(filePath, "wb");
+			if (file == NULL)
+			{
+				std::cout << "Could not save input recording: " << SDL_GetError() << std::endl;
+				return false;
+			}
+
+			SDL_RWwrite(file, "SCRP", 1, 4);
+			SDL_WriteU8(file, FILE_VERSION);
+			SDL_WriteLE32(file, seed);
+			SDL_WriteLE32(file, (Uint32)frames.size());
+
+			//input rarely changes from one frame to the next, so store runs of identical frames
+			size_t i = 0;
+			while (i < frames.size())
+			{
+				Uint8 runLength = 1;
+				while (i + runLength < frames.size() && frames[i + runLength] == frames[i] && runLength < 255)
+				{
+					runLength++;
+				}
+				SDL_WriteU8(file, frames[i]);
+				SDL_WriteU8(file, runLength);
+				i += runLength;
+			}
+
+			SDL_RWclose(file);
+			std::cout << "Saved " << frames.size() << " input frames to " << filePath << std::endl;
+			return true;
+		}
+
+		bool Load(const char* filePath)
+		{
+			SDL_RWops* file = SDL_RWFromFile(filePath, "rb");
+			if (file == NULL)
+			{
+				std::cout << "Could not open input recording: " << SDL_GetError() << std::endl;
+				return false;
+			}
+
+			char magic[4] = {};
+			SDL_RWread(file, magic, 1, 4);
+			if (std::memcmp(magic, "SCRP", 4) != 0 || SDL_ReadU8(file) != FILE_VERSION)
+			{
+				std::cout << "Not a Scorpio input recording: " << filePath << std::endl;
+				SDL_RWclose(file);
+				return false;
+			}
+
+			seed = SDL_ReadLE32(file);
+			Uint32 frameCount = SDL_ReadLE32(file);
+			frames.clear();
+			frames.reserve(frameCount);
+			playhead = 0;
+
+			Uint8 run[2];
+			while (frames.size() < frameCount && SDL_RWread(file, run, 1, 2) == 2)
+			{
+				frames.insert(frames.end(), run[1], run[0]);
+			}
+
+			SDL_RWclose(file);
+			std::cout << "Loaded " << frames.size() << " input frames from " << filePath << std::endl;
+			return frames.size() == frameCount;
+		}
+	};
+
 	//part of AABB collision detection. Returns true if the bounds defined overlap
 	bool AreBoundsOverlapping(int minA, int maxA, int minB, int maxB)
 	{
@@ -324,17 +1052,27 @@ namespace Scorpio
 Scorpio::Sprite playerHealthBar1;
 Scorpio::Sprite playerHealthBar2;
 Scorpio::Sprite playerHealthBar3;
-Scorpio::Sprite scoreSprite;
-Scorpio::Sprite highScoreSprite;
-Scorpio::Sprite gameOverSprite;
-Scorpio::Sprite gameOverSprite2;
-Scorpio::Sprite gameOverSprite3;
+
+//HUD text, rasterised once and reused every frame
+Scorpio::CachedText scoreLabel;
+Scorpio::CachedText highScoreLabel;
+Scorpio::CachedText gameOverText;
+Scorpio::CachedText quitText;
+Scorpio::CachedText restartText;
+Scorpio::DigitAtlas hudDigits; //score numbers are drawn from the SYMB_0..9 digit images
 
 Scorpio::Character playerSoldier;
-//std::vector is a class that allows changing size. This is a dynamic array of Scorpio::Sprite
-std::vector<Scorpio::Bullet> playerBulletContainer; 
-std::vector<Scorpio::Character> enemyContainer; //container of all enemy scorpions
-std::vector<Scorpio::Bullet> enemyBulletContainer; //container of all enemy bullets(poison)
+Scorpio::EntityPool playerBulletPool(MAX_BULLETS); //all player bullets
+Scorpio::EntityPool enemyPool(MAX_ENEMIES); //all enemy scorpions
+Scorpio::EntityPool enemyBulletPool(MAX_BULLETS); //all enemy bullets(poison)
+
+//collision broadphase, rebuilt each frame from the pools
+Scorpio::SpatialGrid enemyGrid(SCREEN_WIDTH, SCREEN_HEIGHT, COLLISION_CELL_SIZE);
+Scorpio::SpatialGrid enemyBulletGrid(SCREEN_WIDTH, SCREEN_HEIGHT, COLLISION_CELL_SIZE);
+std::vector<int> collisionCandidates; //reused query results
+std::vector<int> enemiesHit; //enemies to remove once the bullet pass is done
+std::vector<bool> isEnemyHit(MAX_ENEMIES, false);
+std::vector<int> residentTextures; //textures kept loaded for the whole session so swapping sprites never reloads them
 
 
 const int SCREEN_RIGHT = SCREEN_WIDTH - playerSoldier.sprite.position.x;
@@ -346,6 +1084,13 @@ const int SCREEN_RIGHT = SCREEN_WIDTH - playerSoldier.sprite.position.x;
 //Initialize opens a window and sets up renderer
 bool Init()
 {
+	if (isHeadless)
+	{
+		//SDL's dummy drivers need no display or sound card, the renderer below is only used to load textures
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+	}
+
 	if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
 	{
 		std::cout << "SDL Init Failed! " << SDL_GetError();
@@ -354,7 +1099,7 @@ bool Init()
 	std::cout << "SDL Init Success\n";
 
 	pWindow = SDL_CreateWindow("Elizabeth Gress: 101465946 & David Asher: 101448950", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-		SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+		SCREEN_WIDTH, SCREEN_HEIGHT, isHeadless ? SDL_WINDOW_HIDDEN : 0);
 
 	if (pWindow == NULL) //Error checking
 	{
@@ -366,7 +1111,7 @@ bool Init()
 		std::cout << "window creation success\n";
 	}
 
-	pRenderer = SDL_CreateRenderer(pWindow, -1, 0);
+	pRenderer = SDL_CreateRenderer(pWindow, -1, isHeadless ? SDL_RENDERER_SOFTWARE : 0);
 
 	if (pRenderer == NULL) //Error checking
 	{
@@ -487,7 +1232,23 @@ void loadHealthSprites()
 //Load textures to be displayed on the screen
 void Load()
 {
+	//the health bar swaps to this texture when the player is hit, keep it cached
+	residentTextures.push_back(Scorpio::textureCache.Acquire(pRenderer, "../Assets/textures/UI_HEART_EMPTY.png"));
+
+	//every entity in a pool shares its sprite, so these textures are loaded once for the whole session
+	playerBulletPool.sprite = Scorpio::Sprite(pRenderer, "../Assets/textures/playerprojectile.png");
+	playerBulletPool.sprite.SetSize(125 / 4, 100 / 4);
+
+	int poisonWidth = 50, poisonHeight = 35, poisonFrameCount = 2;
+	enemyBulletPool.sprite = Scorpio::Sprite(pRenderer, "../Assets/textures/poisonprojectile.png", poisonWidth, poisonHeight, poisonFrameCount);
+	enemyBulletPool.sprite.SetSize(125 / 4, 100 / 4);
+
+	int scorpionWidth = 130, scorpionHeight = 96, scorpionFrameCount = 4;
+	enemyPool.sprite = Scorpio::Sprite(pRenderer, "../Assets/textures/Scorpion_walk_sheet.gif", scorpionWidth, scorpionHeight, scorpionFrameCount);
+	enemyPool.sprite.SetSize(125, 100);
+
 	loadHealthSprites();
+	hudDigits.Load(pRenderer, "../Assets/textures/SYMB_%d.png");
 	desertBackground = IMG_LoadTexture(pRenderer, "../Assets/textures/background.bmp");
 	int playerWidth = 131, playerHeight = 100, playerFrameCount = 4;
 	playerSoldier.sprite = Scorpio::Sprite(pRenderer, "../Assets/textures/playerWalk.png", playerWidth, playerHeight, playerFrameCount);
@@ -496,6 +1257,7 @@ void Load()
 	playerSoldier.sprite.SetSize(125, 100);
 	playerSoldier.sprite.position.x = 100;
 	playerSoldier.sprite.position.y = 430;
+	playerSoldier.sprite.SavePreviousPosition();
 }
 
 /// <START FUNCTION>
@@ -524,6 +1286,74 @@ bool isSoundPressed = false;
 bool isQuitPressed = false;
 bool isRestartPressed = false;
 
+Scorpio::InputRecording inputRecording;
+
+/// <INPUT RECORDING FUNCTIONS>
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+Uint8 PackInput()
+{
+	Uint8 inputBits = 0;
+	if (isUpPressed) inputBits |= Scorpio::INPUT_UP;
+	if (isDownPressed) inputBits |= Scorpio::INPUT_DOWN;
+	if (isLeftPressed) inputBits |= Scorpio::INPUT_LEFT;
+	if (isRightPressed) inputBits |= Scorpio::INPUT_RIGHT;
+	if (isShootPressed) inputBits |= Scorpio::INPUT_SHOOT;
+	if (isSoundPressed) inputBits |= Scorpio::INPUT_SOUND;
+	if (isRestartPressed) inputBits |= Scorpio::INPUT_RESTART;
+	if (isQuitPressed) inputBits |= Scorpio::INPUT_QUIT;
+	return inputBits;
+}
+
+void UnpackInput(Uint8 inputBits)
+{
+	isUpPressed = (inputBits & Scorpio::INPUT_UP) != 0;
+	isDownPressed = (inputBits & Scorpio::INPUT_DOWN) != 0;
+	isLeftPressed = (inputBits & Scorpio::INPUT_LEFT) != 0;
+	isRightPressed = (inputBits & Scorpio::INPUT_RIGHT) != 0;
+	isShootPressed = (inputBits & Scorpio::INPUT_SHOOT) != 0;
+	isSoundPressed = (inputBits & Scorpio::INPUT_SOUND) != 0;
+	isRestartPressed = (inputBits & Scorpio::INPUT_RESTART) != 0;
+	isQuitPressed = (inputBits & Scorpio::INPUT_QUIT) != 0;
+}
+
+//Passes one frame of input through the recording: recording stores the live input, replaying replaces it.
+//Call once before every Update() and once when leaving the game over screen.
+//Returns false when a replay has run out of frames
+bool RecordOrReplayInput()
+{
+	if (isRecording)
+	{
+		inputRecording.Add(PackInput());
+	}
+	else if (isReplaying)
+	{
+		Uint8 inputBits;
+		if (!inputRecording.Next(inputBits))
+		{
+			std::cout << "Replay finished" << std::endl;
+			isGameRunning = false;
+			return false;
+		}
+		UnpackInput(inputBits);
+	}
+	return true;
+}
+
+//The game over screen only matters to the simulation on the frame the player restarts or quits, so only that frame is recorded
+void RecordOrReplayGameOverInput()
+{
+	if (isReplaying)
+	{
+		RecordOrReplayInput();
+	}
+	else if (isRestartPressed || isQuitPressed)
+	{
+		RecordOrReplayInput();
+	}
+}
+
 /// <INPUT FUNCTION>
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -594,7 +1424,7 @@ void Input() //take player input
 			case(SDL_SCANCODE_EQUALS):
 			{
 				//increase volume
-				currentAudioVolume = min(currentAudioVolume + 10, MIX_MAX_VOLUME); //min(A,B) takes the smaller of A or B
+				currentAudioVolume = std::min(currentAudioVolume + 10, MIX_MAX_VOLUME); //min(A,B) takes the smaller of A or B
 				Mix_Volume(-1, currentAudioVolume);
 				Mix_VolumeMusic(currentAudioVolume);
 				std::cout << "volume: " << currentAudioVolume << std::endl;
@@ -603,7 +1433,7 @@ void Input() //take player input
 			case(SDL_SCANCODE_MINUS):
 			{
 				//dncrease volume
-				currentAudioVolume = max(currentAudioVolume - 10, 0); //max(A,B) takes the larger of A or B
+				currentAudioVolume = std::max(currentAudioVolume - 10, 0); //max(A,B) takes the larger of A or B
 				Mix_Volume(-1, currentAudioVolume);
 				Mix_VolumeMusic(currentAudioVolume);
 				std::cout << "volume: " << currentAudioVolume << std::endl;
@@ -685,29 +1515,22 @@ void SpawnEnemy()
 	* Read about <random> from C++11 from
 	https://stackoverflow.com/questions/19665818/generate-random-numbers-using-c11-random-library
 	*/
-	std::random_device rd; // obtain a random number from hardware
-	std::mt19937 gen(rd()); // seed the generator
+	//randomGenerator is seeded once in main() so runs with the same seed spawn the same enemies
 	float minSpeed = 80;
 	float maxSpeed = 160;
 	std::uniform_real_distribution<float> dis(minSpeed, maxSpeed); //generate between the min and max speed we set
-	float random = dis(gen); //generate the number
+	float random = dis(randomGenerator); //generate the number
 
-	Scorpio::Sprite enemyScorpion;
-	int scorpionWidth = 130, scorpionHeight = 96, scorpionFrameCount = 4;
-	enemyScorpion = Scorpio::Sprite(pRenderer, "../Assets/textures/Scorpion_walk_sheet.gif", scorpionWidth, scorpionHeight, scorpionFrameCount);
-	//Set size and location of enemy scorpion1
-	enemyScorpion.SetSize(125, 100);
 	//spawning at random position along y, right side of x
-	int maxY = SCREEN_HEIGHT - SCREEN_TOP - (int)enemyScorpion.GetSize().y;
-	enemyScorpion.position = { SCREEN_WIDTH,(float)(rand() % maxY + SCREEN_TOP) };
+	int maxY = SCREEN_HEIGHT - SCREEN_TOP - (int)enemyPool.sprite.GetSize().y;
+	std::uniform_int_distribution<int> spawnY(SCREEN_TOP, SCREEN_TOP + maxY - 1);
+	Scorpio::Vec2 position = { SCREEN_WIDTH,(float)spawnY(randomGenerator) };
 
-	Scorpio::Character enemy;
-	enemy.sprite = enemyScorpion;
-	enemy.fireRepeatDelay = 3.5;
-	enemy.moveSpeedPx = random; //use our random #'s for speed
+	//scorpions walk left at our random speed
+	Scorpio::Vec2 velocity = { -random, 0 };
 
-	//add to list of enemies
-	enemyContainer.push_back(enemy);
+	//add to pool of enemies
+	enemyPool.Spawn(position, velocity);
 
 	//rest timer
 	enemySpawnTimer = enemySpawnDelay;
@@ -734,62 +1557,42 @@ void SpawnEnemiesTimer()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-bool IsSpriteOffscreen(Scorpio::Sprite sprite)
+bool IsSpriteOffscreen(Scorpio::Vec2 position, Scorpio::Vec2 size)
 {
-	if (sprite.position.x + sprite.GetSize().x < 0)
+	if (position.x + size.x < 0)
 		return true;
-	if (sprite.position.x > SCREEN_WIDTH)
+	if (position.x > SCREEN_WIDTH)
 		return true;
-	if (sprite.position.y + sprite.GetSize().y < 0)
+	if (position.y + size.y < 0)
 		return true;
-	if (sprite.position.y > SCREEN_HEIGHT)
+	if (position.y > SCREEN_HEIGHT)
 		return true;
 
 	return false;
 }
 
+//remove every entity of a pool that left the screen. Walks backwards because removal swaps the last entity in
+void RemoveOffscreen(Scorpio::EntityPool& pool)
+{
+	Scorpio::Vec2 size = pool.sprite.GetSize();
+	for (int i = pool.Count() - 1; i >= 0; i--)
+	{
+		if (IsSpriteOffscreen(pool.GetPosition(i), size))
+		{
+			pool.Remove(i);
+		}
+	}
+}
+
 /// <REMOVE OFFSCREEN SPRITES FUNCTION>
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 void RemoveOffscreenSprites()
 {
-	//for each player bullet sprite in container, if offscreen, remove from container
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = playerBulletContainer.begin(); bulletIterator != playerBulletContainer.end();)
-	{
-		if (IsSpriteOffscreen(bulletIterator->sprite))
-		{
-			bulletIterator = playerBulletContainer.erase(bulletIterator);
-		}
-		else
-		{
-			bulletIterator++;
-		}
-	}
-	//for each sprite in container, if offscreen, remove from container
-	for (auto enemyIterator = enemyContainer.begin(); enemyIterator != enemyContainer.end();)
-	{
-		if (IsSpriteOffscreen(enemyIterator->sprite))
-		{
-			enemyIterator = enemyContainer.erase(enemyIterator);
-		}
-		else
-		{
-			enemyIterator++;
-		}
-	}
-	//for each enemy bullet in container, if offscreen, remove from container
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = enemyBulletContainer.begin(); bulletIterator != enemyBulletContainer.end();)
-	{
-		if (IsSpriteOffscreen(bulletIterator->sprite))
-		{
-			bulletIterator = enemyBulletContainer.erase(bulletIterator);
-		}
-		else
-		{
-			bulletIterator++;
-		}
-	}
+	RemoveOffscreen(playerBulletPool);
+	RemoveOffscreen(enemyPool);
+	RemoveOffscreen(enemyBulletPool);
 }
 
 /// <ADD SCORE FUNCTION>
@@ -854,8 +1657,8 @@ void UpdatePlayer()
 	{
 		bool toRight = true;
 		Scorpio::Vec2 velocity = { 400,0 };
-		//passing bulletContainer by reference to add bullets to this container specifically
-		playerSoldier.Shoot(toRight, playerBulletContainer, velocity);
+		//passing the bullet pool by reference to add bullets to this pool specifically
+		playerSoldier.Shoot(toRight, playerBulletPool, velocity);
 		Mix_PlayChannel(-1, pPlayerFire, 0); //play sound
 	}
 
@@ -867,8 +1670,10 @@ void UpdatePlayer()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-void Update() // called every frame at FPS..FPS is declared at the top
+void Update() // advances the game by one fixed step of deltaTime, called FPS times per second
 {
+	playerSoldier.sprite.SavePreviousPosition();
+
 	RemoveOffscreenSprites();
 
 	if (isSoundPressed)
@@ -899,42 +1704,40 @@ void Update() // called every frame at FPS..FPS is declared at the top
 
 	UpdatePlayer();
 
-	//update player bullets 
-	for (int i = 0; i < playerBulletContainer.size(); i++)
-	{
-		playerBulletContainer[i].Update();
-	}
-
-	//update enemy bullets
-	for (int i = 0; i < enemyBulletContainer.size(); i++)
+	//move all bullets and enemy scorpions
+	playerBulletPool.Integrate(deltaTime);
+	enemyBulletPool.Integrate(deltaTime);
+	enemyPool.Integrate(deltaTime);
+	enemyPool.AdvanceFrames(0.1f);
+	enemyPool.TickFireTimers(deltaTime);
+
+	//enemy scorpions shoot when their cooldown is up
+	Scorpio::Vec2 enemySize = enemyPool.sprite.GetSize();
+	Scorpio::Vec2 poisonSize = enemyBulletPool.sprite.GetSize();
+	for (int i = 0; i < enemyPool.Count(); i++)
 	{
-		enemyBulletContainer[i].Update();
-	}
-
-	//update enemy scorpions
-	for (int i = 0; i < enemyContainer.size(); i++)
-	{
-		//get reference to enemy at index[i]
-		Scorpio::Character& enemy = enemyContainer[i];
-
-		enemy.Move({ -1,0 });
-		enemy.sprite.NextFrame();
-		enemy.Update();
-		if (enemy.CanShoot())
+		if (enemyPool.fireRepeatTimer[i] <= 0.0f)
 		{
-			bool toRight = false;
+			Scorpio::Vec2 position = { enemyPool.positionX[i], enemyPool.positionY[i] + ((enemySize.y * 0.5f) + (poisonSize.y * 1.2f)) };
 			Scorpio::Vec2 velocity = { -200, 0 };
-			enemy.Shoot(toRight, enemyBulletContainer, velocity);
+			enemyBulletPool.Spawn(position, velocity);
+			enemyPool.fireRepeatTimer[i] = enemyFireRepeatDelay;
 			Mix_PlayChannel(-1, pEnemyFire, 0);
 		}
 	}
 
 	//collision detection
-	//enemy bullets and player
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = enemyBulletContainer.begin(); bulletIterator != enemyBulletContainer.end();)
+	//enemy bullets and player. Only bullets sharing a grid cell with the player are tested
+	SDL_Rect playerRect = playerSoldier.sprite.GetRect();
+	enemyBulletGrid.Build(enemyBulletPool);
+	enemyBulletGrid.Query(playerRect, collisionCandidates);
+
+	//remove from the highest index down so swap-and-pop never moves a bullet we still need
+	std::sort(collisionCandidates.begin(), collisionCandidates.end(), std::greater<int>());
+	for (int bullet : collisionCandidates)
 	{
-		Scorpio::Sprite& enemyBullet = bulletIterator->sprite;
-		if (Scorpio::AreSpritesOverlapping(playerSoldier.sprite, enemyBullet))
+		SDL_Rect bulletRect = enemyBulletPool.GetRect(bullet);
+		if (SDL_HasIntersection(&playerRect, &bulletRect))
 		{
 			std::cout << "Player was hit" << std::endl;
 			playerSoldier.hitPoints = 0;
@@ -968,41 +1771,47 @@ void Update() // called every frame at FPS..FPS is declared at the top
 				isGameOver = true;
 			}
 
-			//remove this element from container.
-			bulletIterator = enemyBulletContainer.erase(bulletIterator); //erase function returns new index
+			//remove this bullet from the pool
+			enemyBulletPool.Remove(bullet);
 		}
-		if (bulletIterator != enemyBulletContainer.end())  bulletIterator++;
-
 	}
 
-	//for every player bullet
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = playerBulletContainer.begin(); bulletIterator != playerBulletContainer.end();)
+	//player bullets and enemies. Each bullet only tests the enemies in the cells it touches
+	enemyGrid.Build(enemyPool);
+	for (int bullet = playerBulletPool.Count() - 1; bullet >= 0; bullet--)
 	{
-		//for every enemy sprite
-		for (auto enemyIterator = enemyContainer.begin(); enemyIterator != enemyContainer.end();)
+		SDL_Rect bulletRect = playerBulletPool.GetRect(bullet);
+		enemyGrid.Query(bulletRect, collisionCandidates);
+
+		for (int enemy : collisionCandidates)
 		{
-			//test for collision between player bullet and enemy
-			if (Scorpio::AreSpritesOverlapping(bulletIterator->sprite, enemyIterator->sprite))
+			//test for collision between player bullet and enemy, an enemy can only be killed once
+			SDL_Rect enemyRect = enemyPool.GetRect(enemy);
+			if (!isEnemyHit[enemy] && SDL_HasIntersection(&bulletRect, &enemyRect))
 			{
-				//destroy bullet
-				bulletIterator = playerBulletContainer.erase(bulletIterator);
-
-				//destroy enemy
-				enemyIterator = enemyContainer.erase(enemyIterator);
+				//destroy bullet now, the enemy once the pass is done so the grid stays valid
+				playerBulletPool.Remove(bullet);
+				isEnemyHit[enemy] = true;
+				enemiesHit.push_back(enemy);
 				Mix_PlayChannel(-1, pEnemyDeath, 0);
 				AddScore(10); //not sure how many points we want to award, but let's start with 10 for each monster
 
-				//if last object is destroyed, then stop comparing
-				if (bulletIterator == playerBulletContainer.end())
-					break;
-
+				//this bullet is gone, move on to the next one
+				break;
 			}
-
-			if (enemyIterator != enemyContainer.end())  enemyIterator++;
 		}
-		if (bulletIterator != playerBulletContainer.end())  bulletIterator++; //continue as long as not the end
+	}
 
+	//destroy the enemies that were hit, highest index first for swap-and-pop
+	std::sort(enemiesHit.begin(), enemiesHit.end(), std::greater<int>());
+	for (int enemy : enemiesHit)
+	{
+		isEnemyHit[enemy] = false;
+		enemyPool.Remove(enemy);
 	}
+	enemiesHit.clear();
+
+	SpawnEnemiesTimer();
 }
 
 /// <DRAW BACKGROUND FUNCTION>
@@ -1042,52 +1851,39 @@ static void DoBackground()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-void Draw() // draw to screen to show new game state to player
+//draw to screen to show new game state to player.
+//interpolation is how far we are between the last two simulation steps (0 to 1), moving sprites are drawn in between
+void Draw(float interpolation)
 {
-	SpawnEnemiesTimer();
 	SDL_SetRenderDrawColor(pRenderer, 5, 5, 15, 255);
 	SDL_RenderClear(pRenderer);
 
 	DrawBackground();
 
-	playerSoldier.sprite.Draw(pRenderer);
+	playerSoldier.sprite.DrawInterpolated(pRenderer, interpolation);
 
 	playerHealthBar1.Draw(pRenderer);
 	playerHealthBar2.Draw(pRenderer);
 	playerHealthBar3.Draw(pRenderer);
 
 	//draw all bullets onto the screen
-	for (int i = 0; i < playerBulletContainer.size(); i++)
-	{
-		playerBulletContainer[i].sprite.Draw(pRenderer);
-	}
+	playerBulletPool.Draw(pRenderer, interpolation);
 
 	//draw all enemy bullets onto the screen
-	for (int i = 0; i < enemyBulletContainer.size(); i++)
-	{
-		enemyBulletContainer[i].sprite.Draw(pRenderer);
-	}
+	enemyBulletPool.Draw(pRenderer, interpolation);
 
 	//draw all enemy scorpions onto the screen
-	for (int i = 0; i < enemyContainer.size(); i++)
-	{
-		enemyContainer[i].sprite.Draw(pRenderer);
-	}
+	enemyPool.Draw(pRenderer, interpolation);
 
-	std::string scoreText = "Score: " + std::to_string(scoreCurrent);
+	//labels are only rasterised the first time, the numbers come from the digit atlas
 	SDL_Color color = { 0, 0, 0, 0 };
-	scoreSprite.Cleanup();
-	scoreSprite = Scorpio::Sprite(pRenderer, uiFont, scoreText.c_str(), color);
-	scoreSprite.SetPosition(850, 3);
-	scoreSprite.SetSize(100, 65);
-	scoreSprite.Draw(pRenderer);
-
-	std::string highScoreText = "High Score: " + std::to_string(highScoreCurrent);
-	highScoreSprite.Cleanup();
-	highScoreSprite = Scorpio::Sprite(pRenderer, uiFont, highScoreText.c_str(), color);
-	highScoreSprite.SetPosition(150, 3);
-	highScoreSprite.SetSize(150, 65);
-	highScoreSprite.Draw(pRenderer);
+	scoreLabel.SetText(pRenderer, uiFont, "Score:", color);
+	scoreLabel.Draw(pRenderer, 850, 3, 100, 65);
+	hudDigits.DrawNumber(pRenderer, scoreCurrent, 955, 12, 45);
+
+	highScoreLabel.SetText(pRenderer, uiFont, "High Score:", color);
+	highScoreLabel.Draw(pRenderer, 150, 3, 150, 65);
+	hudDigits.DrawNumber(pRenderer, highScoreCurrent, 305, 12, 45);
 
 	//Show the hidden space we were drawing-to called the backbuffer.
 	SDL_RenderPresent(pRenderer);
@@ -1107,23 +1903,14 @@ void GameOverScreen()
 
 	//draw the game over text
 	SDL_Color color = { 0, 0, 0, 255 };
-	gameOverSprite.Cleanup();
-	gameOverSprite = Scorpio::Sprite(pRenderer, uiFont, "GAME OVER", color);
-	gameOverSprite.SetPosition(300, 30);
-	gameOverSprite.SetSize(600, 200);
-	gameOverSprite.Draw(pRenderer);
-
-	gameOverSprite2.Cleanup();
-	gameOverSprite2 = Scorpio::Sprite(pRenderer, uiFont, "Press Q to Quit", color);
-	gameOverSprite2.SetPosition(410, 260);
-	gameOverSprite2.SetSize(350, 200);
-	gameOverSprite2.Draw(pRenderer);
-
-	gameOverSprite3.Cleanup();
-	gameOverSprite3 = Scorpio::Sprite(pRenderer, uiFont, "R to Restart", color);
-	gameOverSprite3.SetPosition(410, 420);
-	gameOverSprite3.SetSize(350, 200);
-	gameOverSprite3.Draw(pRenderer);
+	gameOverText.SetText(pRenderer, uiFont, "GAME OVER", color);
+	gameOverText.Draw(pRenderer, 300, 30, 600, 200);
+
+	quitText.SetText(pRenderer, uiFont, "Press Q to Quit", color);
+	quitText.Draw(pRenderer, 410, 260, 350, 200);
+
+	restartText.SetText(pRenderer, uiFont, "R to Restart", color);
+	restartText.Draw(pRenderer, 410, 420, 350, 200);
 
 	//Show the hidden space we were drawing-to called the backbuffer.
 	SDL_RenderPresent(pRenderer);
@@ -1169,40 +1956,10 @@ void GameOverScreenInput()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 void Restart()
 {
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = enemyBulletContainer.begin(); bulletIterator != enemyBulletContainer.end();)
-	{
-		Scorpio::Sprite& enemyBullet = bulletIterator->sprite;
-		//remove this element from container.
-		bulletIterator = enemyBulletContainer.erase(bulletIterator); //erase function returns new index
-		if (bulletIterator != enemyBulletContainer.end())  bulletIterator++;
-
-	}
-
-	//for every player bullet
-	for (std::vector<Scorpio::Bullet>::iterator bulletIterator = playerBulletContainer.begin(); bulletIterator != playerBulletContainer.end();)
-	{
-		//for every enemy sprite
-		for (auto enemyIterator = enemyContainer.begin(); enemyIterator != enemyContainer.end();)
-		{
-			//test for collision between player bullet and enemy
-			
-				//destroy bullet
-				bulletIterator = playerBulletContainer.erase(bulletIterator);
-
-				//destroy enemy
-				enemyIterator = enemyContainer.erase(enemyIterator);
-				Mix_PlayChannel(-1, pEnemyDeath, 0);
-				AddScore(10); //not sure how many points we want to award, but let's start with 10 for each monster
-
-				//if last object is destroyed, then stop comparing
-				if (bulletIterator == playerBulletContainer.end())
-					break;
-
-			if (enemyIterator != enemyContainer.end())  enemyIterator++;
-		}
-		if (bulletIterator != playerBulletContainer.end())  bulletIterator++; //continue as long as not the end
-
-	}
+	//remove every bullet and enemy left over from the last round
+	playerBulletPool.Clear();
+	enemyBulletPool.Clear();
+	enemyPool.Clear();
 
 	if (isRestartPressed)
 	{
@@ -1229,23 +1986,26 @@ void Restart()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 void Close() //close the game
 {
-	//iterate through all of the sprites and call cleanup
-	for (auto& bullet : playerBulletContainer)
-	{
-		bullet.sprite.Cleanup();
-	}
+	//empty the pools and release their shared sprites
+	playerBulletPool.Clear();
+	playerBulletPool.sprite.Cleanup();
+	enemyBulletPool.Clear();
+	enemyBulletPool.sprite.Cleanup();
+	enemyPool.Clear();
+	enemyPool.sprite.Cleanup();
 
-	for (auto& bullet : enemyBulletContainer)
-	{
-		bullet.sprite.Cleanup();
-	}
+	playerSoldier.sprite.Cleanup();
 
-	for (auto& enemy : enemyContainer)
-	{
-		enemy.sprite.Cleanup();
-	}
+	scoreLabel.Cleanup();
+	highScoreLabel.Cleanup();
+	gameOverText.Cleanup();
+	quitText.Cleanup();
+	restartText.Cleanup();
+	hudDigits.Cleanup();
 
-	playerSoldier.sprite.Cleanup();
+	//destroy every cached texture while the renderer still exists
+	residentTextures.clear();
+	Scorpio::textureCache.Clear();
 
 	//Free the sound effects
 	Mix_FreeChunk(pPlayerFire);
@@ -1277,17 +2037,141 @@ void Close() //close the game
 	SDL_Quit();
 }
 
+/// <COMMAND LINE FUNCTION>
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//--headless runs the simulation only, --frames N sets how many steps it runs, --seed N fixes the random seed,
+//--record file saves this run's input and --replay file plays a saved run back,
+//--pack-atlas text texture output [--embed] converts a text sprite atlas to the packed format instead of playing
+void ParseCommandLine(int argc, char* args[])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(args[i], "--headless") == 0)
+		{
+			isHeadless = true;
+		}
+		else if (std::strcmp(args[i], "--frames") == 0 && i + 1 < argc)
+		{
+			headlessFrameCount = (int)std::strtoul(args[++i], nullptr, 10);
+		}
+		else if (std::strcmp(args[i], "--seed") == 0 && i + 1 < argc)
+		{
+			randomSeed = (unsigned int)std::strtoul(args[++i], nullptr, 10);
+		}
+		else if (std::strcmp(args[i], "--record") == 0 && i + 1 < argc)
+		{
+			isRecording = true;
+			recordingFilePath = args[++i];
+		}
+		else if (std::strcmp(args[i], "--replay") == 0 && i + 1 < argc)
+		{
+			isReplaying = true;
+			recordingFilePath = args[++i];
+		}
+		else if (std::strcmp(args[i], "--pack-atlas") == 0 && i + 3 < argc)
+		{
+			isPackingAtlas = true;
+			atlasFilePaths[0] = args[++i];
+			atlasFilePaths[1] = args[++i];
+			atlasFilePaths[2] = args[++i];
+		}
+		else if (std::strcmp(args[i], "--embed") == 0)
+		{
+			isEmbeddingAtlasImage = true;
+		}
+		else
+		{
+			std::cout << "Unknown argument: " << args[i] << std::endl;
+		}
+	}
+}
+
+/// <HEADLESS LOOP FUNCTION>
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//Runs headlessFrameCount simulation steps back to back with no input, drawing or delay and reports the throughput.
+//The game restarts itself on game over so long soak runs keep going
+void RunHeadless()
+{
+	std::cout << "Running " << headlessFrameCount << " headless frames with seed " << randomSeed << std::endl;
+
+	const auto start = SDL_GetPerformanceCounter();
+	int frame = 0;
+	for (; frame < headlessFrameCount && isGameRunning; frame++)
+	{
+		if (!RecordOrReplayInput())
+		{
+			break;
+		}
+
+		Update();
+
+		DoBackground();
+
+		if (isGameOver)
+		{
+			//a replay restarts or quits exactly where the recorded run did
+			if (!isReplaying)
+			{
+				isRestartPressed = true;
+			}
+			RecordOrReplayGameOverInput();
+			Restart();
+		}
+	}
+	const double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+	//a replay that runs out or a quit stops early, so the frames actually run are reported
+	std::cout << "Simulated " << frame << " frames in " << seconds << " s ("
+		<< (seconds > 0.0 ? frame / seconds : 0.0) << " frames per second)" << std::endl;
+	std::cout << "Final score: " << scoreCurrent << ", high score: " << highScoreCurrent << std::endl;
+}
+
 /// <MAIN FUNCTION>
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* args[])
 {
-	//show and position the application console
-	AllocConsole();
-	auto console = freopen("CON", "w", stdout);
-	const auto window_handle = GetConsoleWindow();
-	MoveWindow(window_handle, 100, 700, 800, 200, TRUE);///
+	ParseCommandLine(argc, args);
+
+	//an offline tool, nothing of the game is started
+	if (isPackingAtlas)
+	{
+		return SpriteAtlas::PackFile(atlasFilePaths[0], atlasFilePaths[1], atlasFilePaths[2], isEmbeddingAtlasImage) ? 0 : 1;
+	}
+
+#ifdef _WIN32
+	if (!isHeadless)
+	{
+		//show and position the application console
+		AllocConsole();
+		auto console = freopen("CON", "w", stdout);
+		const auto window_handle = GetConsoleWindow();
+		MoveWindow(window_handle, 100, 700, 800, 200, TRUE);///
+	}
+#endif
+
+	//a replay has to use the seed of the run it recorded
+	if (isReplaying && inputRecording.Load(recordingFilePath))
+	{
+		randomSeed = inputRecording.seed;
+	}
+	else if (isReplaying)
+	{
+		return 1;
+	}
+
+	if (randomSeed == 0)
+	{
+		std::random_device rd; // obtain a random number from hardware
+		randomSeed = rd();
+	}
+	randomGenerator.seed(randomSeed);
+	inputRecording.seed = randomSeed;
 	const float MAX_FRAME_TIME = 0.1f; // Maximum frame time to prevent large time steps
 	float accumulated_time = 0.0f; // Accumulated time to handle large time steps
 
@@ -1300,40 +2184,93 @@ int main(int argc, char* args[])
 
 	Start();
 
-	
+	if (isHeadless)
+	{
+		if (isGameRunning)
+		{
+			RunHeadless();
+		}
+		if (isRecording)
+		{
+			inputRecording.Save(recordingFilePath);
+		}
+		Close();
+		return 0;
+	}
+
+	const auto counter_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+
 	// Main Game Loop
 	while (isGameRunning)
 	{
-		while (!isGameOver)
+		// start timing fresh after the game over screen so the wait is not simulated
+		auto previous_counter = SDL_GetPerformanceCounter();
+		accumulated_time = 0.0f;
+
+		while (!isGameOver && isGameRunning)
 		{
-			const auto frame_start = static_cast<float>(SDL_GetTicks());
+			const auto frame_start = SDL_GetPerformanceCounter();
+
+			// real time since the last frame, clamped so a long hitch can't demand more steps than we can run (spiral of death)
+			float frame_time = static_cast<float>((frame_start - previous_counter) / counter_frequency);
+			previous_counter = frame_start;
+			if (frame_time > MAX_FRAME_TIME)
+			{
+				frame_time = MAX_FRAME_TIME;
+			}
+			accumulated_time += frame_time;
 
 			Input();
 
-			Update();
+			// run as many fixed steps as the elapsed time covers, simulation speed no longer depends on the frame rate
+			while (accumulated_time >= deltaTime && !isGameOver)
+			{
+				if (!RecordOrReplayInput())
+				{
+					break;
+				}
+
+				Update();
 
-			Draw();
+				DoBackground();
+
+				accumulated_time -= deltaTime;
+			}
 
-			DoBackground();
+			// draw the leftover fraction of a step between the last two simulation states
+			Draw(accumulated_time / deltaTime);
 
-			if (const float frame_time = static_cast<float>(SDL_GetTicks()) - frame_start;
-				frame_time < DELAY_TIME)
+			if (renderFPS > 0.0f)
 			{
-				SDL_Delay(static_cast<int>(DELAY_TIME - frame_time));
+				const float target_frame_ms = 1000.0f / renderFPS;
+				if (const float frame_ms = static_cast<float>((SDL_GetPerformanceCounter() - frame_start) / counter_frequency * 1000.0);
+					frame_ms < target_frame_ms)
+				{
+					SDL_Delay(static_cast<Uint32>(target_frame_ms - frame_ms));
+				}
 			}
+		}
 
-			// delta time
-			const auto delta_time = (static_cast<float>(SDL_GetTicks()) - frame_start) / 1000.0f;
+		if (!isGameRunning)
+		{
+			break;
 		}
 
 		GameOverScreen();
 		
 		GameOverScreenInput();
+
+		RecordOrReplayGameOverInput();
 		
 		Restart();
 
 	}
 
+	if (isRecording)
+	{
+		inputRecording.Save(recordingFilePath);
+	}
+
 	Close();
 
 	return 0;
@@ -1,4 +1,5 @@
 #include "Ship.h"
+#include <cmath>
 #include "glm/gtx/string_cast.hpp"
 #include "PlayScene.h"
 #include "TextureManager.h"
@@ -7,8 +8,9 @@
 Ship::Ship() : m_maxSpeed(10.0f)
 {
 	TextureManager::Instance().Load("../Assets/textures/ship3.png", "ship");
+	m_texture = TextureManager::Instance().GetTextureHandle("ship");
 
-	const auto size = TextureManager::Instance().GetTextureSize("ship");
+	const auto size = TextureManager::Instance().GetTextureSize(m_texture);
 	SetWidth(static_cast<int>(size.x));
 	SetHeight(static_cast<int>(size.y));
 
@@ -33,7 +35,7 @@ Ship::~Ship()
 void Ship::Draw()
 {
 	// draw the ship
-	TextureManager::Instance().Draw("ship", GetTransform()->position, GetCurrentHeading(), 255, true);
+	TextureManager::Instance().Draw(m_texture, GetTransform()->position, GetCurrentHeading(), 255, true);
 
 	// draw LOS
 	Util::DrawLine(GetTransform()->position, GetTransform()->position + GetCurrentDirection() * GetLOSDistance(), GetLOSColour());
@@ -44,6 +46,17 @@ void Ship::Update()
 {
 	/*move();
 	m_checkBounds();*/
+
+	// a steered ship is moved by its scene's SteeringSystem, it only turns to face where it is going
+	if (IsSimulated())
+	{
+		const auto velocity = GetRigidBody()->velocity;
+		if (Util::SquaredMagnitude(velocity) > Util::EPSILON)
+		{
+			const float heading = std::atan2(velocity.y, velocity.x) * Util::Rad2Deg;
+			SetCurrentHeading(heading < 0.0f ? heading + 360.0f : heading);
+		}
+	}
 }
 
 void Ship::Clean()
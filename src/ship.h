@@ -37,6 +37,7 @@ private:
 
 	float m_maxSpeed;
 	float m_turnRate;
+	TextureHandle m_texture;
 
 };
 